@@ -0,0 +1,247 @@
+#include "gtest/gtest.h"
+#include "goap/planners/AStarGoapPlanner.h"
+#include "goap/planners/PlanningStats.h"
+#include "goap/IGoal.h"
+#include "goap/BaseGoal.h"
+#include "goap/IAction.h"
+#include "goap/BaseAction.h"
+#include "goap/IPredicate.h"
+#include "goap/BasePredicate.h"
+#include "GoapTestUtils.h"
+
+#include <string>
+
+using namespace NAI::Goap;
+
+TEST(NAI_AStarGoalPlanner, When_NoPredicates_Then_NoPlan)
+{
+	std::vector<std::shared_ptr<IGoal>> goals;
+	std::vector<std::shared_ptr<IPredicate>> predicates;
+
+	auto planner = std::make_shared<AStarGoapPlanner>();
+
+	auto plan = planner->GetPlan(goals, predicates);
+
+	ASSERT_EQ(plan, nullptr);
+}
+
+TEST(NAI_AStarGoalPlanner, When_PredicatesAnGoalsButNoSatisfied_Then_NoPlan)
+{
+	std::vector<std::shared_ptr<IGoal>> goals;
+	std::vector<std::shared_ptr<IPredicate>> predicates;
+
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+	predicates.push_back(predicateA);
+
+	std::vector<std::shared_ptr<IAction>> actions;
+	actions.push_back(CreateActionWith({ predicateB->GetText() }, { predicateC }, 0));
+
+	goals.push_back(std::make_shared<BaseGoal>(actions));
+
+	auto planner = std::make_shared<AStarGoapPlanner>();
+	auto plan = planner->GetPlan(goals, predicates);
+
+	ASSERT_EQ(plan, nullptr);
+}
+
+TEST(NAI_AStarGoalPlanner, When_OnePredicateChainsOneActionAndThatActionAnotherOfTheSameGoal_Then_TwoActionsGoalPlan)
+{
+	std::vector<std::shared_ptr<IAction>> actions;
+	std::vector<std::shared_ptr<IPredicate>> predicates;
+	std::vector<std::shared_ptr<IGoal>> goals;
+
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	predicates.push_back(predicateA);
+
+	actions.push_back(CreateActionWith({ predicateB->GetText() }, { predicateC }, 0));
+	actions.push_back(CreateActionWith({ predicateA->GetText() }, { predicateB }, 0));
+
+	goals.push_back(std::make_shared<BaseGoal>(actions));
+
+	auto planner = std::make_shared<AStarGoapPlanner>();
+
+	auto plan = planner->GetPlan(goals, predicates);
+
+	ASSERT_TRUE(plan != nullptr);
+	ASSERT_TRUE(plan->GetNextAction() != nullptr);
+	ASSERT_TRUE(plan->GetNextAction() != nullptr);
+	ASSERT_TRUE(plan->GetNextAction() == nullptr);
+}
+
+TEST(NAI_AStarGoalPlanner, When_TwoGoalsAreSatisfied_Then_LessCostGoalPlan)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	std::vector<std::shared_ptr<IGoal>> goals;
+	std::vector<std::shared_ptr<IAction>> actions = { CreateActionWith({ predicateB->GetText() }, { predicateC }, 3) };
+	goals.push_back(std::make_shared<BaseGoal>(actions));
+
+	actions = { CreateActionWith({ predicateA->GetText() }, { predicateC }, 1) };
+	goals.push_back(std::make_shared<BaseGoal>(actions));
+
+	auto planner = std::make_shared<AStarGoapPlanner>();
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+
+	auto plan = planner->GetPlan(goals, predicates);
+
+	ASSERT_TRUE(plan != nullptr);
+	ASSERT_EQ(plan->GetCost(), 1);
+}
+
+TEST(NAI_AStarGoalPlanner, When_OneGoalMultipleActions_And_OneActionCanNotBeSatisfied_Then_NoPlan)
+{
+	const auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	const auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	const auto predicateD = std::make_shared<BasePredicate>(4, "D");
+	const auto predicateE = std::make_shared<BasePredicate>(5, "E");
+
+	std::vector<std::shared_ptr<IAction>> actions = {
+		CreateActionWith({ predicateD->GetText(), predicateA->GetText() }, { predicateE }, 1),
+		CreateActionWith({ predicateB->GetText() }, { predicateD }, 1)
+	};
+	std::vector<std::shared_ptr<IGoal>> goals = { std::make_shared<BaseGoal>(actions) };
+
+	auto planner = std::make_shared<AStarGoapPlanner>();
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateB };
+
+	const auto plan = planner->GetPlan(goals, predicates);
+
+	ASSERT_TRUE(!plan);
+}
+
+TEST(NAI_AStarGoalPlanner, When_WeWantAPlanThatSatisfiesAGivenPredicateWithMoreThanOneGoal_Then_LessCostGoalPlan)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+	auto predicateD = std::make_shared<BasePredicate>(4, "D");
+	auto predicateE = std::make_shared<BasePredicate>(5, "E");
+	auto predicateF = std::make_shared<BasePredicate>(6, "F");
+	auto predicateG = std::make_shared<BasePredicate>(7, "G");
+
+	auto action1 = CreateActionWith({ predicateA->GetText() }, { predicateC }, 1);
+	auto action2 = CreateActionWith({ predicateC->GetText() }, { predicateE }, 1);
+	auto action3 = CreateActionWith({ predicateA->GetText(), predicateE->GetText() }, { predicateF }, 1);
+	auto action4 = CreateActionWith({ predicateB->GetText() }, { predicateD }, 1);
+	auto action5 = CreateActionWith({ predicateC->GetText(), predicateD->GetText() }, { predicateG }, 1);
+	auto action6 = CreateActionWith({ predicateA->GetText() }, { predicateF }, 4);
+	auto action7 = CreateActionWith({ predicateB->GetText(), predicateF->GetText() }, { predicateG }, 4);
+
+	std::vector<std::shared_ptr<IGoal>> goals;
+	goals.push_back(std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{ action1, action2, action3 }));
+	goals.push_back(std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{ action4, action5 }));
+	goals.push_back(std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{ action6, action7 }));
+
+	auto planner = std::make_shared<AStarGoapPlanner>();
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+	std::vector<std::shared_ptr<IPredicate>> desiredPredicates = { predicateF, predicateG };
+
+	auto plan = planner->GetPlanToReach(goals, predicates, desiredPredicates);
+
+	ASSERT_TRUE(!plan.empty());
+	ASSERT_EQ(plan[0]->GetCost(), 3);
+	ASSERT_EQ(plan[1]->GetCost(), 2);
+}
+
+//Expanded nodes are the ones whose successors were generated, the node reaching the
+//desired predicates is taken from the open list but not expanded.
+
+TEST(NAI_AStarGoalPlanner, When_ManyGoalsDoNotProduceTheDesiredPredicate_Then_TheyAreNotExpanded)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	std::vector<std::shared_ptr<IGoal>> goals;
+	goals.push_back(std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{
+		CreateActionWith({ predicateA->GetText() }, { predicateB }, 1) }));
+	goals.push_back(std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{
+		CreateActionWith({ predicateB->GetText() }, { predicateC }, 1) }));
+
+	//goals reachable from A but producing predicates nobody asked for,
+	//after any of them C still costs 2 so they are never better than the plan
+	for (auto i = 0; i < 20; ++i)
+	{
+		const auto distractor = std::make_shared<BasePredicate>(100 + i, "Distractor" + std::to_string(i));
+		goals.push_back(std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{
+			CreateActionWith({ predicateA->GetText() }, { distractor }, 1) }));
+	}
+
+	auto planner = std::make_shared<AStarGoapPlanner>();
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA };
+	std::vector<std::shared_ptr<IPredicate>> desiredPredicates = { predicateC };
+	PlanningStats stats;
+
+	auto plan = planner->GetPlanToReach(goals, predicates, desiredPredicates, stats);
+
+	ASSERT_EQ(plan.size(), 2);
+	ASSERT_TRUE(plan[0] == goals[0]);
+	ASSERT_TRUE(plan[1] == goals[1]);
+	//the initial node and the one after A -> B
+	ASSERT_EQ(stats.numExpandedNodes, 2);
+}
+
+TEST(NAI_AStarGoalPlanner, When_ExpensiveGoalsAreSatisfied_Then_TheyAreNotExpanded)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	std::vector<std::shared_ptr<IGoal>> goals;
+	for (auto i = 0; i < 20; ++i)
+	{
+		const auto expensive = std::make_shared<BasePredicate>(100 + i, "Expensive" + std::to_string(i));
+		goals.push_back(std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{
+			CreateActionWith({ predicateA->GetText() }, { expensive }, 5) }));
+	}
+	goals.push_back(std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{
+		CreateActionWith({ predicateA->GetText() }, { predicateC }, 1) }));
+
+	auto planner = std::make_shared<AStarGoapPlanner>();
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA };
+	PlanningStats stats;
+
+	auto plan = planner->GetPlan(goals, predicates, stats);
+
+	ASSERT_TRUE(plan == goals.back());
+	//only the initial node
+	ASSERT_EQ(stats.numExpandedNodes, 1);
+}
+
+TEST(NAI_AStarGoalPlanner, When_ActionsCostNothing_Then_LessCostPlanAlthoughItHasMoreGoals)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	std::vector<std::shared_ptr<IGoal>> goals;
+	goals.push_back(std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{
+		CreateActionWith({ predicateA->GetText() }, { predicateC }, 1) }));
+	goals.push_back(std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{
+		CreateActionWith({ predicateA->GetText() }, { predicateB }, 0) }));
+	goals.push_back(std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{
+		CreateActionWith({ predicateB->GetText() }, { predicateC }, 0) }));
+
+	auto planner = std::make_shared<AStarGoapPlanner>();
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA };
+	std::vector<std::shared_ptr<IPredicate>> desiredPredicates = { predicateC };
+
+	//counting steps would overestimate zero-cost actions
+	auto plan = planner->GetPlanToReach(goals, predicates, desiredPredicates);
+
+	ASSERT_EQ(plan.size(), 2);
+	ASSERT_TRUE(plan[0] == goals[1]);
+	ASSERT_TRUE(plan[1] == goals[2]);
+}
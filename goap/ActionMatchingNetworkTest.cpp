@@ -0,0 +1,204 @@
+#include "gtest/gtest.h"
+#include "goap/planners/ActionMatchingNetwork.h"
+#include "goap/IGoal.h"
+#include "goap/BaseGoal.h"
+#include "goap/IAction.h"
+#include "goap/BaseAction.h"
+#include "goap/IPredicate.h"
+#include "goap/BasePredicate.h"
+#include "goap/PredicatesHandler.h"
+#include "GoapTestUtils.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace NAI::Goap;
+
+static bool ContainsAction(const std::vector<std::shared_ptr<IAction>>& actions, const std::shared_ptr<IAction>& action)
+{
+	return std::find(actions.begin(), actions.end(), action) != actions.end();
+}
+
+TEST(NAI_ActionMatchingNetwork, When_NoPredicates_Then_NoApplicableActions)
+{
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	const auto action = CreateActionWith({ "A" }, { predicateB }, 1);
+
+	const ActionMatchingNetwork network({ std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{ action }) });
+
+	ASSERT_TRUE(network.GetApplicableActions().empty());
+	ASSERT_FALSE(network.IsApplicable(action));
+}
+
+TEST(NAI_ActionMatchingNetwork, When_PredicateSatisfiesThePrecondition_Then_ActionIsApplicable)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	const auto action = CreateActionWith({ predicateA->GetText() }, { predicateB }, 1);
+
+	ActionMatchingNetwork network({ std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{ action }) });
+	network.OnPredicateAdded(predicateA);
+
+	ASSERT_EQ(network.GetApplicableActions().size(), 1);
+	ASSERT_TRUE(network.IsApplicable(action));
+}
+
+TEST(NAI_ActionMatchingNetwork, When_OnlySomePreconditionsAreSatisfied_Then_ActionIsNotApplicable)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+	const auto action = CreateActionWith({ predicateA->GetText(), predicateB->GetText() }, { predicateC }, 1);
+
+	ActionMatchingNetwork network({ std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{ action }) });
+
+	network.OnPredicateAdded(predicateA);
+	ASSERT_FALSE(network.IsApplicable(action));
+
+	network.OnPredicateAdded(predicateB);
+	ASSERT_TRUE(network.IsApplicable(action));
+
+	network.OnPredicateRemoved(predicateA->GetID());
+	ASSERT_FALSE(network.IsApplicable(action));
+	ASSERT_TRUE(network.GetApplicableActions().empty());
+}
+
+TEST(NAI_ActionMatchingNetwork, When_ActionsOfDifferentGoalsShareAPrecondition_Then_TheyShareTheNodeAndAllOfThemAreApplicable)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+	const auto action1 = CreateActionWith({ predicateA->GetText() }, { predicateB }, 1);
+	const auto action2 = CreateActionWith({ predicateA->GetText() }, { predicateC }, 1);
+
+	ActionMatchingNetwork network({
+		std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{ action1 }),
+		std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{ action2 }) });
+
+	//one node per distinct precondition
+	ASSERT_EQ(network.GetNumNodes(), 1);
+
+	network.OnPredicateAdded(predicateA);
+
+	const auto& applicableActions = network.GetApplicableActions();
+	ASSERT_EQ(applicableActions.size(), 2);
+	ASSERT_TRUE(applicableActions[0] == action1);
+	ASSERT_TRUE(applicableActions[1] == action2);
+}
+
+TEST(NAI_ActionMatchingNetwork, When_PredicateIsReplacedWithTheSameId_Then_ItIsCountedOnce)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	const auto action = CreateActionWith({ predicateA->GetText() }, { predicateB }, 1);
+
+	ActionMatchingNetwork network({ std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{ action }) });
+
+	network.OnPredicateAdded(predicateA);
+	network.OnPredicateAdded(std::make_shared<BasePredicate>(predicateA->GetID(), "A"));
+	network.OnPredicateRemoved(predicateA->GetID());
+
+	ASSERT_FALSE(network.IsApplicable(action));
+}
+
+TEST(NAI_ActionMatchingNetwork, When_PredicateIsReplacedWithAnotherText_Then_OldPreconditionIsNotSatisfiedAnymore)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(1, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+	const auto actionA = CreateActionWith({ predicateA->GetText() }, { predicateC }, 1);
+	const auto actionB = CreateActionWith({ predicateB->GetText() }, { predicateC }, 1);
+
+	ActionMatchingNetwork network({ std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{ actionA, actionB }) });
+
+	network.OnPredicateAdded(predicateA);
+	network.OnPredicateAdded(predicateB);
+
+	ASSERT_FALSE(network.IsApplicable(actionA));
+	ASSERT_TRUE(network.IsApplicable(actionB));
+}
+
+TEST(NAI_ActionMatchingNetwork, When_PredicatesChangeRandomly_Then_SameApplicableActionsThanMatchingAllOfThem)
+{
+	//fixed seed, so a failure can be reproduced
+	std::mt19937 random(1234);
+	const auto numPredicates = 12;
+	const auto numActions = 30;
+
+	std::vector<std::shared_ptr<IPredicate>> allPredicates;
+	for (auto i = 0; i < numPredicates; ++i)
+	{
+		allPredicates.push_back(std::make_shared<BasePredicate>(i, "P" + std::to_string(i)));
+	}
+
+	std::uniform_int_distribution<int> predicateDistribution(0, numPredicates - 1);
+	std::uniform_int_distribution<int> numPreconditionsDistribution(1, 3);
+	std::vector<std::shared_ptr<IAction>> actions;
+	for (auto i = 0; i < numActions; ++i)
+	{
+		std::vector<std::string> preconditions;
+		for (auto j = numPreconditionsDistribution(random); j > 0; --j)
+		{
+			preconditions.push_back(allPredicates[predicateDistribution(random)]->GetText());
+		}
+		actions.push_back(CreateActionWith(preconditions, { allPredicates[predicateDistribution(random)] }, 1));
+	}
+	const auto goal = std::make_shared<BaseGoal>(actions);
+
+	ActionMatchingNetwork network({ goal });
+	std::vector<std::shared_ptr<IPredicate>> predicates;
+	const auto checkSameApplicableActions = [&]()
+	{
+		for (auto&& action : actions)
+		{
+			const auto satisfied = action->GetPredicatesSatisfyPreconditions(predicates).size() == action->GetPreconditions().size();
+			ASSERT_EQ(network.IsApplicable(action), satisfied);
+			ASSERT_EQ(ContainsAction(network.GetApplicableActions(), action), satisfied);
+		}
+	};
+
+	//each step adds the chosen predicate when it's not there and removes it otherwise
+	for (auto step = 0; step < 500; ++step)
+	{
+		const auto& predicate = allPredicates[predicateDistribution(random)];
+		const auto found = std::find(predicates.begin(), predicates.end(), predicate);
+		if (found == predicates.end())
+		{
+			predicates.push_back(predicate);
+			network.OnPredicateAdded(predicate);
+		}
+		else
+		{
+			predicates.erase(found);
+			network.OnPredicateRemoved(predicate->GetID());
+		}
+		ASSERT_NO_FATAL_FAILURE(checkSameApplicableActions());
+	}
+}
+
+TEST(NAI_ActionMatchingNetwork, When_SubscribedToThePredicatesHandler_Then_ItFollowsItsChanges)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+	const auto action = CreateActionWith({ predicateA->GetText(), predicateB->GetText() }, { predicateC }, 1);
+
+	const auto network = std::make_shared<ActionMatchingNetwork>(std::vector<std::shared_ptr<IGoal>>{ std::make_shared<BaseGoal>(std::vector<std::shared_ptr<IAction>>{ action }) });
+	PredicatesHandler predicatesHandler;
+	predicatesHandler.Subscribe(network);
+
+	predicatesHandler.AddOrReplace(predicateA);
+	predicatesHandler.AddOrReplace(predicateB);
+	ASSERT_TRUE(network->IsApplicable(action));
+
+	//replaced with another text
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(predicateB->GetID(), "D"));
+	ASSERT_FALSE(network->IsApplicable(action));
+
+	predicatesHandler.AddOrReplace(predicateB);
+	ASSERT_TRUE(network->IsApplicable(action));
+
+	predicatesHandler.Remove(predicateA->GetID());
+	ASSERT_FALSE(network->IsApplicable(action));
+	ASSERT_TRUE(network->GetApplicableActions().empty());
+}
@@ -3,6 +3,9 @@
 #include "goap/BaseAction.h"
 #include "goap/IPredicate.h"
 #include "goap/BasePredicate.h"
+#ifdef NAI_NEXT_API
+#include "goap/PredicateSymbolTable.h"
+#endif
 
 #include <memory>
 #include <vector>
@@ -57,4 +60,40 @@ TEST(NAI_Action, When_PredicatesSatisfyPreconditions_Then_ListOfPredicates)
 	ASSERT_TRUE(predicatesSatisfy.size() == 2);
 	ASSERT_TRUE(predicatesSatisfy[0] == predicateA);
 	ASSERT_TRUE(predicatesSatisfy[1] == predicateC);
-}
\ No newline at end of file
+}
+
+#ifdef NAI_NEXT_API
+TEST(NAI_Action, When_Created_Then_PreconditionsAreInternedAsAtoms)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	std::vector<std::string> preconditions{ predicateA->GetText(), predicateC->GetText() };
+	std::vector<std::shared_ptr<IPredicate>> postconditions{ predicateB };
+
+	auto action = std::make_shared<BaseAction>(preconditions, postconditions);
+
+	const auto& atoms = action->GetPreconditionAtoms();
+
+	ASSERT_EQ(atoms.size(), preconditions.size());
+	ASSERT_EQ(atoms[0], predicateA->GetAtom());
+	ASSERT_EQ(atoms[1], predicateC->GetAtom());
+}
+
+TEST(NAI_Action, When_PredicateWithSameTextButOtherInstance_Then_SatisfiesPrecondition)
+{
+	std::vector<std::string> preconditions{ "A" };
+	std::vector<std::shared_ptr<IPredicate>> postconditions{ std::make_shared<BasePredicate>(2, "B") };
+
+	auto action = std::make_shared<BaseAction>(preconditions, postconditions);
+
+	const auto predicateA = std::make_shared<BasePredicate>(7, std::string("A"));
+	std::vector<std::shared_ptr<IPredicate>> inputPredicates{ predicateA };
+
+	auto predicatesSatisfy = action->GetPredicatesSatisfyPreconditions(inputPredicates);
+
+	ASSERT_TRUE(predicatesSatisfy.size() == 1);
+	ASSERT_TRUE(predicatesSatisfy[0] == predicateA);
+}
+#endif
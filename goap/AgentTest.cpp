@@ -6,12 +6,21 @@
 #include "goap/BasePredicate.h"
 #include "goap/BaseAction.h"
 #include "goap/IGoapPlanner.h"
+#ifdef NAI_NEXT_API
+#include "goap/IPlanningSearch.h"
+#include "goap/PlanningBudget.h"
+#endif
 #include <goap/sensory/IStimulus.h>
 
 #include "goap/agent/AgentBuilder.h"
 
+#include <algorithm>
+
 using namespace NAI::Goap;
 using ::testing::NiceMock;
+using ::testing::DoDefault;
+using ::testing::Invoke;
+using ::testing::Return;
 
 class AgentMock : public BaseAgent
 {
@@ -181,6 +190,57 @@ public:
 			std::vector<std::shared_ptr<IPredicate>>&));
 };
 
+#ifdef NAI_NEXT_API
+class ResumablePlanningSearch : public IPlanningSearch
+{
+public:
+	ResumablePlanningSearch(unsigned int numResumesToFinish, std::shared_ptr<IGoal> plan) :
+	mNumResumesToFinish{ numResumesToFinish },
+	mPlan{ plan }
+	{
+	}
+	virtual ~ResumablePlanningSearch() = default;
+
+	bool IsFinished() const override { return mNumResumesToFinish == 0; }
+	std::shared_ptr<IGoal> GetBestPlan() const override { return IsFinished() ? mPlan : nullptr; }
+	void Resume(const PlanningBudget& budget) override
+	{
+		if (mNumResumesToFinish > 0)
+		{
+			--mNumResumesToFinish;
+		}
+	}
+
+private:
+	unsigned int mNumResumesToFinish;
+	std::shared_ptr<IGoal> mPlan;
+};
+
+class ThreeFramesGoapPlannerMock : public OneActionGoapPlannerMock
+{
+public:
+	ThreeFramesGoapPlannerMock() = default;
+	virtual ~ThreeFramesGoapPlannerMock() = default;
+
+	std::shared_ptr<IPlanningSearch> GetPlan(
+		std::vector<std::shared_ptr<IGoal>>& goals,
+		std::vector<std::shared_ptr<IPredicate>>& predicates,
+		const PlanningBudget& budget) const override
+	{
+		auto predicateA = std::make_shared<BasePredicate>(1, "A");
+		auto predicateB = std::make_shared<BasePredicate>(2, "B");
+
+		std::vector<std::string> preconditions = { predicateA->GetText() };
+		std::vector<std::shared_ptr<IPredicate>> postconditions = { predicateB };
+		std::vector<std::shared_ptr<IAction>> actions;
+		actions.push_back(std::make_shared<BaseAction>(preconditions, postconditions));
+
+		//first frame starts the search, it needs two more frames to finish
+		return std::make_shared<ResumablePlanningSearch>(2, std::make_shared<BaseGoal>(actions));
+	}
+};
+#endif
+
 class GoalAcceptanceHearingStimulusMock : public BaseGoal
 {
 public:
@@ -213,6 +273,35 @@ public:
 	MOCK_CONST_METHOD1(TransformStimulusIntoPredicates, std::shared_ptr<IPredicate>(const ShortTermMemory<IStimulus>&));
 };
 
+#ifdef NAI_NEXT_API
+class CheaperWithPredicateGoal : public BaseGoal
+{
+public:
+	CheaperWithPredicateGoal(const std::string& predicateText) : mPredicateText{ predicateText } {}
+	virtual ~CheaperWithPredicateGoal() = default;
+
+	unsigned int GetCost(std::vector<std::shared_ptr<IPredicate>>& inputPredicates, std::vector<std::shared_ptr<IPredicate>>& accomplishedPredicates) const override
+	{
+		const auto found = std::find_if(inputPredicates.begin(), inputPredicates.end(),
+			[this](const std::shared_ptr<IPredicate>& predicate) { return predicate->GetText() == mPredicateText; });
+
+		return found == inputPredicates.end() ? 10 : 1;
+	}
+
+private:
+	std::string mPredicateText;
+};
+
+class RepairPlanGoalMock : public BaseGoal
+{
+public:
+	RepairPlanGoalMock(const std::vector<std::shared_ptr<IAction>>& actions) : BaseGoal(actions) {}
+	virtual ~RepairPlanGoalMock() = default;
+
+	MOCK_METHOD1(DoCancel, void(std::vector<std::shared_ptr<IPredicate>>& predicates));
+};
+#endif
+
 class HearingStimulusMock : public IStimulus
 {
 public:
@@ -375,4 +464,335 @@ TEST(NAI_Agent, When_TransformAnStimulusToPredicatesUnRelatedToAGoal_Then_Null)
 
 TEST(NAI_Agent, When_Update_Then_InstantPredicatesAreRemoved)
 {
-}
\ No newline at end of file
+#ifdef NAI_NEXT_API
+	const auto goapPlannerMock = std::make_shared<NiceMock<EmptyGoapPlannerMock>>();
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(goapPlannerMock)
+                                            .WithPredicate(std::make_shared<BasePredicate>(1, "A"))
+                                            .Build<AgentMock>();
+
+	const auto instantPredicate = std::make_shared<BasePredicate>(2, "B");
+	instantPredicate->SetTimeToLive(0.5f);
+	agent->OnNewPredicate(instantPredicate);
+
+	agent->Update(0.0f);
+	ASSERT_TRUE(agent->HasPredicate(2));
+
+	agent->Update(0.3f);
+	ASSERT_TRUE(agent->HasPredicate(2));
+
+	agent->Update(0.3f); //time to live is over
+
+	ASSERT_FALSE(agent->HasPredicate(2));
+	ASSERT_TRUE(agent->HasPredicate(1));
+#endif
+}
+
+#ifdef NAI_NEXT_API
+TEST(NAI_Agent, When_InstantPredicateIsReplaced_Then_ItsTimeToLiveStartsAgain)
+{
+	const auto goapPlannerMock = std::make_shared<NiceMock<EmptyGoapPlannerMock>>();
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(goapPlannerMock)
+                                            .Build<AgentMock>();
+
+	auto instantPredicate = std::make_shared<BasePredicate>(2, "B");
+	instantPredicate->SetTimeToLive(0.5f);
+	agent->OnNewPredicate(instantPredicate);
+
+	agent->Update(0.0f);
+	agent->Update(0.3f);
+
+	instantPredicate = std::make_shared<BasePredicate>(2, "B");
+	instantPredicate->SetTimeToLive(0.5f);
+	agent->OnNewPredicate(instantPredicate);
+
+	agent->Update(0.3f);
+	ASSERT_TRUE(agent->HasPredicate(2));
+
+	agent->Update(0.3f);
+	ASSERT_FALSE(agent->HasPredicate(2));
+}
+
+TEST(NAI_Agent, When_InstantPredicateIsReplacedWithoutTimeToLive_Then_ItIsNotRemoved)
+{
+	const auto goapPlannerMock = std::make_shared<NiceMock<EmptyGoapPlannerMock>>();
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(goapPlannerMock)
+                                            .Build<AgentMock>();
+
+	const auto instantPredicate = std::make_shared<BasePredicate>(2, "B");
+	instantPredicate->SetTimeToLive(0.5f);
+	agent->OnNewPredicate(instantPredicate);
+	agent->Update(0.0f);
+
+	agent->OnNewPredicate(std::make_shared<BasePredicate>(2, "B"));
+	agent->Update(1.0f);
+
+	ASSERT_TRUE(agent->HasPredicate(2));
+}
+
+TEST(NAI_Agent, When_PlanRepairAndNewPredicateUnrelatedToThePlan_Then_KeepsProcessing)
+{
+	const auto goapPlannerMock = std::make_shared<NiceMock<TwoActionGoapPlannerMock>>();
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(goapPlannerMock)
+                                            .WithPredicate(goapPlannerMock->predicateA)
+                                            .WithPlanRepair(true)
+                                            .Build<AgentMock>();
+
+	EXPECT_CALL(*goapPlannerMock, GetPlan).Times(1);
+
+	agent->Update(0.0f); //-->get a plan changing state processing
+	agent->Update(0.0f); //now it's processing the first action
+
+	agent->OnNewPredicate(std::make_shared<BasePredicate>(4, "D"));
+
+	agent->Update(0.0f); //the new predicate is not used by the plan, then it's processing second action and finishes plan
+
+	ASSERT_TRUE(agent->HasPredicate(4));
+	ASSERT_TRUE(agent->HasPredicate(goapPlannerMock->predicateC->GetID()));
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PLANNING);
+}
+
+TEST(NAI_Agent, When_PlanRepairAndNewPredicateInvalidatesAPreconditionOfTheRemainingPlan_Then_Planning)
+{
+	const auto goapPlannerMock = std::make_shared<NiceMock<TwoActionGoapPlannerMock>>();
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(goapPlannerMock)
+                                            .WithPredicate(goapPlannerMock->predicateA)
+                                            .WithPlanRepair(true)
+                                            .Build<AgentMock>();
+
+	ASSERT_FALSE(agent->HasPredicate(goapPlannerMock->predicateC->GetID()));
+
+	agent->Update(0.0f); //-->get a plan changing state processing
+	agent->Update(0.0f); //now it's processing the first action
+
+	//the second action of the plan needs B, and B is being replaced by a predicate that doesn't satisfy it
+	agent->OnNewPredicate(std::make_shared<BasePredicate>(goapPlannerMock->predicateB->GetID(), "NOT B"));
+
+	agent->Update(0.0f); //the remaining plan is not valid anymore, then planning
+
+	ASSERT_FALSE(agent->HasPredicate(goapPlannerMock->predicateC->GetID()));
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PLANNING);
+}
+
+TEST(NAI_Agent, When_PlanRepairAndNewPredicateReplacesAPreconditionWithTheSameContent_Then_KeepsProcessing)
+{
+	const auto goapPlannerMock = std::make_shared<NiceMock<TwoActionGoapPlannerMock>>();
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(goapPlannerMock)
+                                            .WithPredicate(goapPlannerMock->predicateA)
+                                            .WithPlanRepair(true)
+                                            .Build<AgentMock>();
+
+	EXPECT_CALL(*goapPlannerMock, GetPlan).Times(1);
+
+	agent->Update(0.0f); //-->get a plan changing state processing
+	agent->Update(0.0f); //now it's processing the first action
+
+	//another instance of B, but nothing the plan depends on has changed
+	agent->OnNewPredicate(std::make_shared<BasePredicate>(goapPlannerMock->predicateB->GetID(), "B"));
+
+	agent->Update(0.0f); //processing second action and finishes plan
+
+	ASSERT_TRUE(agent->HasPredicate(goapPlannerMock->predicateC->GetID()));
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PLANNING);
+}
+
+TEST(NAI_Agent, When_PlanRepairAndNewPredicateMakesAGoalCheaper_Then_RemainingPlanIsReplanned)
+{
+	const auto goapPlannerMock = std::make_shared<NiceMock<TwoActionGoapPlannerMock>>();
+	const auto predicateD = std::make_shared<BasePredicate>(4, "D");
+	const auto cheaperGoal = std::make_shared<CheaperWithPredicateGoal>(predicateD->GetText());
+
+	const auto firstAction = std::make_shared<BaseAction>(
+		std::vector<std::string>{ goapPlannerMock->predicateA->GetText() },
+		std::vector<std::shared_ptr<IPredicate>>{ goapPlannerMock->predicateB });
+	const auto secondAction = std::make_shared<BaseAction>(
+		std::vector<std::string>{ goapPlannerMock->predicateB->GetText() },
+		std::vector<std::shared_ptr<IPredicate>>{ goapPlannerMock->predicateC });
+	const auto plan = std::make_shared<NiceMock<RepairPlanGoalMock>>(std::vector<std::shared_ptr<IAction>>{ firstAction, secondAction });
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(goapPlannerMock)
+                                            .WithGoal(cheaperGoal)
+                                            .WithPredicate(goapPlannerMock->predicateA)
+                                            .WithPlanRepair(true)
+                                            .Build<AgentMock>();
+
+	//the plan is repaired, never aborted
+	EXPECT_CALL(*plan, DoCancel).Times(0);
+
+	std::vector<std::shared_ptr<IGoal>> replanGoals;
+	std::vector<std::shared_ptr<IPredicate>> replanPredicates;
+	EXPECT_CALL(*goapPlannerMock, GetPlan)
+		.WillOnce(Return(plan))
+		.WillOnce(
+			[&replanGoals, &replanPredicates](std::vector<std::shared_ptr<IGoal>>& goals, std::vector<std::shared_ptr<IPredicate>>& predicates)
+			{
+				replanGoals = goals;
+				replanPredicates = predicates;
+				return std::shared_ptr<IGoal>();
+			});
+
+	agent->Update(0.0f); //-->get a plan changing state processing
+	agent->Update(0.0f); //now it's processing the first action
+
+	//D doesn't break the plan, but the goal is cheaper now
+	agent->OnNewPredicate(predicateD);
+
+	agent->Update(0.0f); //the remaining plan is replanned
+	ASSERT_FALSE(agent->HasPredicate(goapPlannerMock->predicateC->GetID()));
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PLANNING);
+
+	agent->Update(0.0f);
+
+	//only the remaining suffix goes back to the planner, next to the goal that got cheaper
+	const auto hasAction = [](const std::shared_ptr<IGoal>& goal, const std::shared_ptr<IAction>& action)
+	{
+		const auto& actions = goal->GetActions();
+		return std::find(actions.begin(), actions.end(), action) != actions.end();
+	};
+	ASSERT_TRUE(std::find(replanGoals.begin(), replanGoals.end(), plan) == replanGoals.end());
+	ASSERT_TRUE(std::find(replanGoals.begin(), replanGoals.end(), cheaperGoal) != replanGoals.end());
+	ASSERT_TRUE(std::none_of(replanGoals.begin(), replanGoals.end(),
+		[&](const std::shared_ptr<IGoal>& goal) { return hasAction(goal, firstAction); }));
+	ASSERT_EQ(std::count_if(replanGoals.begin(), replanGoals.end(),
+		[&](const std::shared_ptr<IGoal>& goal) { return goal->GetActions().size() == 1 && hasAction(goal, secondAction); }), 1);
+
+	//the first action is not done again, the new plan starts from B
+	const auto hasPredicate = [&replanPredicates](int id)
+	{
+		return std::any_of(replanPredicates.begin(), replanPredicates.end(), [id](const std::shared_ptr<IPredicate>& predicate) { return predicate->GetID() == id; });
+	};
+	ASSERT_TRUE(hasPredicate(goapPlannerMock->predicateB->GetID()));
+	ASSERT_TRUE(hasPredicate(predicateD->GetID()));
+	ASSERT_FALSE(hasPredicate(goapPlannerMock->predicateC->GetID()));
+}
+
+TEST(NAI_Agent, When_PlanningWithBudgetAndSearchNotFinished_Then_KeepsPlanningUntilItFinishes)
+{
+	const auto goapPlannerMock = std::make_shared<NiceMock<ThreeFramesGoapPlannerMock>>();
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(goapPlannerMock)
+                                            .WithPlanningBudget(PlanningBudget::WithMaxExpandedNodes(10))
+                                            .Build<AgentMock>();
+
+	//the budgeted search is used instead of the blocking one
+	EXPECT_CALL(*goapPlannerMock, GetPlan).Times(0);
+
+	agent->Update(0.0f); //starts the search
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PLANNING);
+
+	agent->Update(0.0f); //resumes the search
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PLANNING);
+
+	agent->Update(0.0f); //resumes and finishes the search
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PROCESSING);
+}
+
+TEST(NAI_Agent, When_PlanningWithBudgetAndPlannerWithoutBudgetSupport_Then_PlanInOneFrame)
+{
+	const auto goapPlannerMock = std::make_shared<NiceMock<OneActionGoapPlannerMock>>();
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(goapPlannerMock)
+                                            .WithPlanningBudget(PlanningBudget::WithMaxExpandedNodes(10))
+                                            .Build<AgentMock>();
+
+	EXPECT_CALL(*goapPlannerMock, GetPlan).Times(1);
+
+	agent->Update(0.0f);
+
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PROCESSING);
+}
+
+TEST(NAI_Agent, When_SpeculativePlanningAndProcessing_Then_NextPlanIsComputedWithThePredictedPredicates)
+{
+	const auto goapPlannerMock = std::make_shared<NiceMock<TwoActionGoapPlannerMock>>();
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(goapPlannerMock)
+                                            .WithPredicate(goapPlannerMock->predicateA)
+                                            .WithSpeculativePlanning(true)
+                                            .Build<AgentMock>();
+
+	std::vector<std::shared_ptr<IPredicate>> predictedPredicates;
+	EXPECT_CALL(*goapPlannerMock, GetPlan)
+		.WillOnce(DoDefault())
+		.WillOnce(Invoke(
+			[&predictedPredicates](std::vector<std::shared_ptr<IGoal>>& goals, std::vector<std::shared_ptr<IPredicate>>& predicates)
+			{
+				predictedPredicates = predicates;
+				return std::shared_ptr<IGoal>();
+			}));
+
+	agent->Update(0.0f); //-->get a plan changing state processing
+	agent->Update(0.0f); //now it's processing the first action and plans the next goal ahead
+
+	const auto hasPredicate = [&predictedPredicates](int id)
+	{
+		return std::any_of(predictedPredicates.begin(), predictedPredicates.end(),
+			[id](const std::shared_ptr<IPredicate>& predicate) { return predicate->GetID() == id; });
+	};
+
+	//current predicates plus the postconditions of the plan being processed
+	ASSERT_TRUE(hasPredicate(goapPlannerMock->predicateA->GetID()));
+	ASSERT_TRUE(hasPredicate(goapPlannerMock->predicateC->GetID()));
+	ASSERT_FALSE(agent->HasPredicate(goapPlannerMock->predicateC->GetID()));
+}
+
+TEST(NAI_Agent, When_SpeculativePlanningAndPlanFinished_Then_ProcessesThePreparedPlan)
+{
+	const auto goapPlannerMock = std::make_shared<NiceMock<TwoActionGoapPlannerMock>>();
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(goapPlannerMock)
+                                            .WithPredicate(goapPlannerMock->predicateA)
+                                            .WithSpeculativePlanning(true)
+                                            .Build<AgentMock>();
+
+	EXPECT_CALL(*goapPlannerMock, GetPlan).Times(2);
+
+	agent->Update(0.0f); //-->get a plan changing state processing
+	agent->Update(0.0f); //now it's processing first action and plans the next goal ahead
+	agent->Update(0.0f); //now it's processing second action, finishes plan and takes the prepared one
+
+	ASSERT_TRUE(agent->HasPredicate(goapPlannerMock->predicateC->GetID()));
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PROCESSING);
+}
+
+TEST(NAI_Agent, When_SpeculativePlanningAndNewPredicateBeforePlanFinished_Then_PreparedPlanIsDiscarded)
+{
+	const auto goapPlannerMock = std::make_shared<NiceMock<TwoActionGoapPlannerMock>>();
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(goapPlannerMock)
+                                            .WithPredicate(goapPlannerMock->predicateA)
+                                            .WithPlanRepair(true)
+                                            .WithSpeculativePlanning(true)
+                                            .Build<AgentMock>();
+
+	EXPECT_CALL(*goapPlannerMock, GetPlan).Times(2);
+
+	agent->Update(0.0f); //-->get a plan changing state processing
+	agent->Update(0.0f); //now it's processing first action and plans the next goal ahead
+
+	//unrelated to the current plan, but it wasn't known when the next plan was prepared
+	agent->OnNewPredicate(std::make_shared<BasePredicate>(4, "D"));
+
+	agent->Update(0.0f); //finishes plan, the prepared plan is not valid anymore
+
+	ASSERT_TRUE(agent->HasPredicate(goapPlannerMock->predicateC->GetID()));
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PLANNING);
+}
+#endif
@@ -0,0 +1,401 @@
+#include "gtest/gtest.h"
+#include "goap/agent/AgentWorld.h"
+#include "goap/agent/AgentBuilder.h"
+#include "goap/agent/BaseAgent.h"
+#include "goap/planners/TreeGoapPlanner.h"
+#include "goap/BaseGoal.h"
+#include "goap/BaseAction.h"
+#include "goap/BasePredicate.h"
+#include "goap/sensory/BaseSensor.h"
+#include "goap/sensory/IStimulus.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace NAI::Goap;
+
+class WorldAgentMock : public BaseAgent
+{
+public:
+	WorldAgentMock(const std::shared_ptr<IGoapPlanner> goapPlanner,
+		const std::vector<std::shared_ptr<IGoal>>& goals,
+		const std::vector<std::shared_ptr<IPredicate>>& predicates) :
+	WorldAgentMock(goapPlanner, goals, predicates, nullptr)
+	{
+	}
+
+	WorldAgentMock(const std::shared_ptr<IGoapPlanner> goapPlanner,
+		const std::vector<std::shared_ptr<IGoal>>& goals,
+		const std::vector<std::shared_ptr<IPredicate>>& predicates,
+		const std::shared_ptr<PerceptionSystem> perceptionSystem) :
+	BaseAgent(goapPlanner, goals, predicates, perceptionSystem)
+	{
+	}
+
+	virtual ~WorldAgentMock() = default;
+
+	glm::vec3 GetPosition() const override { return glm::vec3(0.0f); }
+	void MoveTo(float elapsedTime, const glm::vec3& point) override {}
+};
+
+class WorldStimulus : public IStimulus
+{
+public:
+	WorldStimulus() = default;
+	virtual ~WorldStimulus() = default;
+
+	std::string GetClassName() const override { return typeid(WorldStimulus).name(); }
+	glm::vec3 GetPosition() const override { return glm::vec3(0.0f); }
+	float GetDurationInMemory() const override { return 60.0f; }
+	unsigned GetId() const override { return 1; }
+};
+
+class WorldStimulusSensor : public BaseSensor
+{
+public:
+	WorldStimulusSensor() = default;
+	virtual ~WorldStimulusSensor() = default;
+};
+
+class WorldAcceptAllThreshold : public IThreshold
+{
+public:
+	WorldAcceptAllThreshold() = default;
+	virtual ~WorldAcceptAllThreshold() = default;
+
+	bool IsStimulusPerceived(std::shared_ptr<IStimulus> stimulus) const override { return true; }
+};
+
+//Perceiving the stimulus gives the predicate A the goal needs to be planned
+class WorldStimulusGoal : public BaseGoal
+{
+public:
+	WorldStimulusGoal(const std::vector<std::shared_ptr<IAction>>& actions) : BaseGoal(actions) {}
+	virtual ~WorldStimulusGoal() = default;
+
+protected:
+	std::shared_ptr<IPredicate> DoTransformStimulusIntoPredicates(const ShortTermMemory<IStimulus>& memory) const override
+	{
+		std::shared_ptr<IPredicate> predicate = nullptr;
+
+		memory.PerformActionForEach(
+			[&predicate](std::shared_ptr<IStimulus> stimulus) -> bool
+			{
+				predicate = std::make_shared<BasePredicate>(1, "A");
+				return true;
+			});
+
+		return predicate;
+	}
+};
+
+//Takes a ticket from a counter shared by all agents every time one of them runs a phase,
+//so a test can check the order the phases of different agents ran in.
+class WorldPhaseRecorder
+{
+public:
+	void RecordCognition() { Record(mCognitionTickets); }
+	void RecordPlanning() { Record(mPlanningTickets); }
+
+	std::vector<unsigned int> GetCognitionTickets() const { std::lock_guard<std::mutex> lock(mMutex); return mCognitionTickets; }
+	std::vector<unsigned int> GetPlanningTickets() const { std::lock_guard<std::mutex> lock(mMutex); return mPlanningTickets; }
+
+private:
+	void Record(std::vector<unsigned int>& tickets)
+	{
+		const auto ticket = mCounter++;
+		std::lock_guard<std::mutex> lock(mMutex);
+		tickets.push_back(ticket);
+	}
+
+	std::atomic<unsigned int> mCounter{ 0 };
+	mutable std::mutex mMutex;
+	std::vector<unsigned int> mCognitionTickets;
+	std::vector<unsigned int> mPlanningTickets;
+};
+
+class PhaseRecordingGoal : public WorldStimulusGoal
+{
+public:
+	PhaseRecordingGoal(const std::vector<std::shared_ptr<IAction>>& actions, const std::shared_ptr<WorldPhaseRecorder>& recorder) :
+	WorldStimulusGoal(actions),
+	mRecorder{ recorder }
+	{
+	}
+	virtual ~PhaseRecordingGoal() = default;
+
+protected:
+	std::shared_ptr<IPredicate> DoTransformStimulusIntoPredicates(const ShortTermMemory<IStimulus>& memory) const override
+	{
+		mRecorder->RecordCognition();
+		return WorldStimulusGoal::DoTransformStimulusIntoPredicates(memory);
+	}
+
+private:
+	std::shared_ptr<WorldPhaseRecorder> mRecorder;
+};
+
+class PhaseRecordingGoapPlanner : public IGoapPlanner
+{
+public:
+	PhaseRecordingGoapPlanner(const std::shared_ptr<WorldPhaseRecorder>& recorder) : mRecorder{ recorder } {}
+	virtual ~PhaseRecordingGoapPlanner() = default;
+
+	std::shared_ptr<IGoal> GetPlan(std::vector<std::shared_ptr<IGoal>>& goals, std::vector<std::shared_ptr<IPredicate>>& predicates) const override
+	{
+		mRecorder->RecordPlanning();
+		return mPlanner.GetPlan(goals, predicates);
+	}
+
+	std::vector<std::shared_ptr<IGoal>> GetPlanToReach(
+		std::vector<std::shared_ptr<IGoal>>& goals,
+		std::vector<std::shared_ptr<IPredicate>>& predicates,
+		std::vector<std::shared_ptr<IPredicate>>& desiredPredicates) const override
+	{
+		return mPlanner.GetPlanToReach(goals, predicates, desiredPredicates);
+	}
+
+private:
+	std::shared_ptr<WorldPhaseRecorder> mRecorder;
+	TreeGoapPlanner mPlanner;
+};
+
+class WorldPerceptionSystemMock : public PerceptionSystem
+{
+public:
+	WorldPerceptionSystemMock(std::shared_ptr<SensorySystem<IStimulus>> sensorySystem) : PerceptionSystem(sensorySystem) {}
+	virtual ~WorldPerceptionSystemMock() = default;
+};
+
+struct WorldAgentResult
+{
+	AgentState state;
+	std::vector<bool> hasPredicates;
+
+	bool operator==(const WorldAgentResult& other) const { return state == other.state && hasPredicates == other.hasPredicates; }
+};
+
+//Every agent has its own goal, they keep state while planning and processing.
+//All of them share the planner, as agents in a game do. One of each three agents has nothing to plan for.
+static std::shared_ptr<BaseAgent> CreateWorldAgent(unsigned int index, const std::shared_ptr<IGoapPlanner>& planner)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	std::vector<std::shared_ptr<IAction>> actions = {
+		std::make_shared<BaseAction>(std::vector<std::string>{ predicateA->GetText() }, std::vector<std::shared_ptr<IPredicate>>{ predicateB }),
+		std::make_shared<BaseAction>(std::vector<std::string>{ predicateB->GetText() }, std::vector<std::shared_ptr<IPredicate>>{ predicateC }) };
+
+	AgentBuilder agentBuilder;
+	agentBuilder.WithGoapPlanner(planner)
+				.WithGoal(std::make_shared<BaseGoal>(actions));
+	if (index % 3 != 0)
+	{
+		agentBuilder.WithPredicate(predicateA);
+	}
+
+	return agentBuilder.Build<WorldAgentMock>();
+}
+
+static std::vector<std::shared_ptr<BaseAgent>> CreateWorldAgents(unsigned int numAgents)
+{
+	const auto planner = std::make_shared<TreeGoapPlanner>();
+
+	std::vector<std::shared_ptr<BaseAgent>> agents;
+	for (unsigned int i = 0; i < numAgents; ++i)
+	{
+		agents.push_back(CreateWorldAgent(i, planner));
+	}
+
+	return agents;
+}
+
+static std::vector<WorldAgentResult> GetResults(const std::vector<std::shared_ptr<BaseAgent>>& agents)
+{
+	std::vector<WorldAgentResult> results;
+	for (auto&& agent : agents)
+	{
+		results.push_back({ agent->GetCurrentState(), { agent->HasPredicate(1), agent->HasPredicate(2), agent->HasPredicate(3) } });
+	}
+
+	return results;
+}
+
+static std::vector<WorldAgentResult> UpdateWorld(unsigned int numThreads, unsigned int numAgents, unsigned int numFrames)
+{
+	const auto agents = CreateWorldAgents(numAgents);
+
+	AgentWorld world(numThreads);
+	for (auto&& agent : agents)
+	{
+		world.AddAgent(agent);
+	}
+
+	for (unsigned int frame = 0; frame < numFrames; ++frame)
+	{
+		world.Update(0.016f);
+	}
+
+	return GetResults(agents);
+}
+
+TEST(NAI_AgentWorld, When_Created_Then_NoAgents)
+{
+	AgentWorld world(4);
+
+	world.Update(0.016f);
+
+	ASSERT_EQ(world.GetNumAgents(), 0);
+	ASSERT_EQ(world.GetNumThreads(), 4);
+}
+
+TEST(NAI_AgentWorld, When_AddingAndRemovingAgents_Then_OnlyTheAddedOnesAreUpdated)
+{
+	AgentWorld world(2);
+	const auto planner = std::make_shared<TreeGoapPlanner>();
+	const auto agent1 = CreateWorldAgent(1, planner);
+	const auto agent2 = CreateWorldAgent(2, planner);
+
+	world.AddAgent(agent1);
+	world.AddAgent(agent2);
+	ASSERT_EQ(world.GetNumAgents(), 2);
+
+	ASSERT_TRUE(world.RemoveAgent(agent2));
+	ASSERT_FALSE(world.RemoveAgent(agent2));
+	ASSERT_EQ(world.GetNumAgents(), 1);
+
+	world.Update(0.016f);
+
+	ASSERT_TRUE(agent1->GetCurrentState() == AgentState::STATE_PROCESSING);
+	ASSERT_TRUE(agent2->GetCurrentState() == AgentState::STATE_PLANNING);
+}
+
+TEST(NAI_AgentWorld, When_Updating_Then_SameResultThanUpdatingEachAgent)
+{
+	const auto numAgents = 100;
+	const auto numFrames = 5;
+
+	const auto agents = CreateWorldAgents(numAgents);
+	for (auto frame = 0; frame < numFrames; ++frame)
+	{
+		for (auto&& agent : agents)
+		{
+			agent->Update(0.016f);
+		}
+	}
+
+	ASSERT_TRUE(UpdateWorld(4, numAgents, numFrames) == GetResults(agents));
+}
+
+TEST(NAI_AgentWorld, When_UpdatingWithDifferentNumberOfThreads_Then_SameResult)
+{
+	const auto numAgents = 1000;
+	const auto numFrames = 5;
+
+	const auto results = UpdateWorld(1, numAgents, numFrames);
+
+	for (auto numThreads : { 2u, 3u, 8u })
+	{
+		ASSERT_TRUE(UpdateWorld(numThreads, numAgents, numFrames) == results);
+	}
+}
+
+TEST(NAI_AgentWorld, When_NewPredicateBetweenUpdates_Then_AgentReceivesIt)
+{
+	AgentWorld world(4);
+	const auto agents = CreateWorldAgents(8);
+	for (auto&& agent : agents)
+	{
+		world.AddAgent(agent);
+	}
+
+	//agent 0 has nothing to plan for until it gets A
+	world.Update(0.016f);
+	ASSERT_TRUE(agents[0]->GetCurrentState() == AgentState::STATE_PLANNING);
+
+	agents[0]->OnNewPredicate(std::make_shared<BasePredicate>(1, "A"));
+	world.Update(0.016f);
+
+	ASSERT_TRUE(agents[0]->HasPredicate(1));
+	ASSERT_TRUE(agents[0]->GetCurrentState() == AgentState::STATE_PROCESSING);
+}
+
+TEST(NAI_AgentWorld, When_AgentPerceivesAPredicate_Then_ItIsPlannedWithItInTheSameUpdate)
+{
+	const auto sensorySystem = std::make_shared<SensorySystem<IStimulus>>();
+	WorldStimulusSensor sensor;
+	sensor.Subscribe(sensorySystem);
+
+	const auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	std::vector<std::shared_ptr<IAction>> actions = {
+		std::make_shared<BaseAction>(std::vector<std::string>{ "A" }, std::vector<std::shared_ptr<IPredicate>>{ predicateB }) };
+	std::vector<std::shared_ptr<IGoal>> goals = { std::make_shared<WorldStimulusGoal>(actions) };
+	std::vector<std::shared_ptr<IPredicate>> predicates;
+
+	const auto agent = std::make_shared<WorldAgentMock>(
+		std::make_shared<TreeGoapPlanner>(),
+		goals,
+		predicates,
+		std::make_shared<WorldPerceptionSystemMock>(sensorySystem));
+	agent->AddSensoryThreshold(typeid(WorldStimulus).name(), std::make_shared<WorldAcceptAllThreshold>());
+	agent->StartUp();
+
+	AgentWorld world(2);
+	world.AddAgent(agent);
+
+	sensor.NotifyAll(std::make_shared<WorldStimulus>());
+	world.Update(0.016f);
+
+	//the perception phase runs before the planning phase
+	ASSERT_TRUE(agent->HasPredicate(1));
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PROCESSING);
+}
+
+TEST(NAI_AgentWorld, When_Updating_Then_EveryAgentFinishesAPhaseBeforeAnyAgentStartsTheNextOne)
+{
+	const auto numAgents = 16;
+	const auto recorder = std::make_shared<WorldPhaseRecorder>();
+	const auto planner = std::make_shared<PhaseRecordingGoapPlanner>(recorder);
+	const auto predicateB = std::make_shared<BasePredicate>(2, "B");
+
+	AgentWorld world(4);
+	std::vector<std::shared_ptr<WorldStimulusSensor>> sensors;
+	for (auto i = 0; i < numAgents; ++i)
+	{
+		const auto sensorySystem = std::make_shared<SensorySystem<IStimulus>>();
+		const auto sensor = std::make_shared<WorldStimulusSensor>();
+		sensor->Subscribe(sensorySystem);
+		sensors.push_back(sensor);
+
+		std::vector<std::shared_ptr<IAction>> actions = {
+			std::make_shared<BaseAction>(std::vector<std::string>{ "A" }, std::vector<std::shared_ptr<IPredicate>>{ predicateB }) };
+		std::vector<std::shared_ptr<IGoal>> goals = { std::make_shared<PhaseRecordingGoal>(actions, recorder) };
+		std::vector<std::shared_ptr<IPredicate>> predicates;
+
+		const auto agent = std::make_shared<WorldAgentMock>(
+			planner,
+			goals,
+			predicates,
+			std::make_shared<WorldPerceptionSystemMock>(sensorySystem));
+		agent->AddSensoryThreshold(typeid(WorldStimulus).name(), std::make_shared<WorldAcceptAllThreshold>());
+		agent->StartUp();
+		world.AddAgent(agent);
+	}
+
+	for (auto&& sensor : sensors)
+	{
+		sensor->NotifyAll(std::make_shared<WorldStimulus>());
+	}
+	world.Update(0.016f);
+
+	//updating one agent after another would plan the first agent before the cognition of the second one
+	const auto cognitionTickets = recorder->GetCognitionTickets();
+	const auto planningTickets = recorder->GetPlanningTickets();
+	ASSERT_GE(cognitionTickets.size(), static_cast<size_t>(numAgents));
+	ASSERT_GE(planningTickets.size(), static_cast<size_t>(numAgents));
+	ASSERT_LT(*std::max_element(cognitionTickets.begin(), cognitionTickets.end()), *std::min_element(planningTickets.begin(), planningTickets.end()));
+}
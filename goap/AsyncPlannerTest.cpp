@@ -0,0 +1,295 @@
+#include "gtest/gtest.h"
+#include "goap/planners/AsyncGoapPlanner.h"
+#include "goap/planners/TreeGoapPlanner.h"
+#include "goap/IPlanningSearch.h"
+#include "goap/PlanningBudget.h"
+#include "goap/BaseGoal.h"
+#include "goap/BaseAction.h"
+#include "goap/BasePredicate.h"
+#include "goap/agent/AgentBuilder.h"
+#include "goap/agent/BaseAgent.h"
+#include "GoapTestUtils.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace NAI::Goap;
+
+//Blocks every plan until it is opened, and records the predicates ids each plan received
+class GatedGoapPlanner : public IGoapPlanner
+{
+public:
+	GatedGoapPlanner() : mPlanner{ std::make_shared<TreeGoapPlanner>() }, mIsOpen{ false } {}
+	virtual ~GatedGoapPlanner() = default;
+
+	std::shared_ptr<IGoal> GetPlan(std::vector<std::shared_ptr<IGoal>>& goals, std::vector<std::shared_ptr<IPredicate>>& predicates) const override
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mCondition.wait(lock, [this]() { return mIsOpen; });
+
+		std::vector<int> ids;
+		for (auto&& predicate : predicates)
+		{
+			ids.push_back(predicate->GetID());
+		}
+		mReceivedPredicateIds.push_back(ids);
+		lock.unlock();
+
+		return mPlanner->GetPlan(goals, predicates);
+	}
+
+	std::vector<std::shared_ptr<IGoal>> GetPlanToReach(
+		std::vector<std::shared_ptr<IGoal>>& goals,
+		std::vector<std::shared_ptr<IPredicate>>& predicates,
+		std::vector<std::shared_ptr<IPredicate>>& desiredPredicates) const override
+	{
+		return mPlanner->GetPlanToReach(goals, predicates, desiredPredicates);
+	}
+
+	void Open()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mIsOpen = true;
+		mCondition.notify_all();
+	}
+
+	std::vector<std::vector<int>> GetReceivedPredicateIds() const
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mReceivedPredicateIds;
+	}
+
+private:
+	std::shared_ptr<TreeGoapPlanner> mPlanner;
+	mutable std::mutex mMutex;
+	mutable std::condition_variable mCondition;
+	bool mIsOpen;
+	mutable std::vector<std::vector<int>> mReceivedPredicateIds;
+};
+
+class AsyncAgentMock : public BaseAgent
+{
+public:
+	AsyncAgentMock(const std::shared_ptr<IGoapPlanner> goapPlanner,
+		const std::vector<std::shared_ptr<IGoal>>& goals,
+		const std::vector<std::shared_ptr<IPredicate>>& predicates) :
+	AsyncAgentMock(goapPlanner, goals, predicates, nullptr)
+	{
+	}
+
+	AsyncAgentMock(const std::shared_ptr<IGoapPlanner> goapPlanner,
+		const std::vector<std::shared_ptr<IGoal>>& goals,
+		const std::vector<std::shared_ptr<IPredicate>>& predicates,
+		const std::shared_ptr<PerceptionSystem> perceptionSystem) :
+	BaseAgent(goapPlanner, goals, predicates, perceptionSystem)
+	{
+	}
+
+	virtual ~AsyncAgentMock() = default;
+
+	glm::vec3 GetPosition() const override { return glm::vec3(0.0f); }
+	void MoveTo(float elapsedTime, const glm::vec3& point) override {}
+};
+
+//two goals reaching C: one needs B and costs 3, the other one needs A and costs 1
+static std::vector<std::shared_ptr<IGoal>> CreateTwoGoalsWithDifferentCost(const std::shared_ptr<IPredicate>& predicateA, const std::shared_ptr<IPredicate>& predicateB)
+{
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	std::vector<std::shared_ptr<IGoal>> goals;
+	std::vector<std::shared_ptr<IAction>> actions = { CreateActionWith({ predicateB->GetText() }, { predicateC }, 3) };
+	goals.push_back(std::make_shared<BaseGoal>(actions));
+
+	actions = { CreateActionWith({ predicateA->GetText() }, { predicateC }, 1) };
+	goals.push_back(std::make_shared<BaseGoal>(actions));
+
+	return goals;
+}
+
+TEST(NAI_AsyncGoapPlanner, When_PlanIsRequested_Then_ItIsNotFinishedUntilItIsDispatched)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto goals = CreateTwoGoalsWithDifferentCost(predicateA, predicateB);
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+
+	auto planner = std::make_shared<AsyncGoapPlanner>(std::make_shared<TreeGoapPlanner>(), 2);
+
+	const auto search = planner->GetPlan(goals, predicates, PlanningBudget::Unlimited());
+
+	ASSERT_TRUE(search != nullptr);
+	ASSERT_FALSE(search->IsFinished());
+
+	planner->WaitForAll();
+	//the plan is ready but it's only handed back on the simulation thread
+	ASSERT_FALSE(search->IsFinished());
+
+	const auto numDispatched = planner->DispatchCompletedPlans();
+
+	ASSERT_EQ(numDispatched, 1);
+	ASSERT_TRUE(search->IsFinished());
+	ASSERT_TRUE(search->GetBestPlan() != nullptr);
+	ASSERT_EQ(search->GetBestPlan()->GetCost(), 1);
+	ASSERT_EQ(planner->GetNumPendingRequests(), 0);
+}
+
+TEST(NAI_AsyncGoapPlanner, When_PredicatesChangeAfterTheRequest_Then_PlanUsesTheSnapshot)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto goals = CreateTwoGoalsWithDifferentCost(predicateA, predicateB);
+	auto blockingGoals = CreateTwoGoalsWithDifferentCost(predicateA, predicateB);
+
+	const auto gatedPlanner = std::make_shared<GatedGoapPlanner>();
+	auto planner = std::make_shared<AsyncGoapPlanner>(gatedPlanner, 1);
+
+	//the only worker is blocked with this request until the gate is opened
+	std::vector<std::shared_ptr<IPredicate>> blockingPredicates = { predicateB };
+	const auto blockingSearch = planner->GetPlan(blockingGoals, blockingPredicates, PlanningBudget::Unlimited());
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+	const auto search = planner->GetPlan(goals, predicates, PlanningBudget::Unlimited());
+
+	//the worker can't have read the predicates yet
+	predicates = { std::make_shared<BasePredicate>(4, "D") };
+
+	gatedPlanner->Open();
+	planner->WaitForAll();
+	planner->DispatchCompletedPlans();
+
+	const auto receivedPredicateIds = gatedPlanner->GetReceivedPredicateIds();
+
+	ASSERT_EQ(receivedPredicateIds.size(), 2);
+	ASSERT_EQ(receivedPredicateIds[1], std::vector<int>({ 1, 2 }));
+	ASSERT_TRUE(search->IsFinished());
+	ASSERT_TRUE(search->GetBestPlan() == goals[1]);
+	ASSERT_TRUE(blockingSearch->GetBestPlan() == blockingGoals[0]);
+}
+
+TEST(NAI_AsyncGoapPlanner, When_CallerGoalsAndPredicatesAreDestroyedAfterTheRequest_Then_PlanIsStillBuilt)
+{
+	const auto gatedPlanner = std::make_shared<GatedGoapPlanner>();
+	auto planner = std::make_shared<AsyncGoapPlanner>(gatedPlanner, 1);
+
+	std::shared_ptr<IPlanningSearch> search;
+	{
+		auto predicateA = std::make_shared<BasePredicate>(1, "A");
+		auto predicateB = std::make_shared<BasePredicate>(2, "B");
+		auto goals = CreateTwoGoalsWithDifferentCost(predicateA, predicateB);
+		std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+
+		search = planner->GetPlan(goals, predicates, PlanningBudget::Unlimited());
+	}
+
+	//the request copied the goals list and the predicates when it was submitted
+	gatedPlanner->Open();
+	planner->WaitForAll();
+	planner->DispatchCompletedPlans();
+
+	const auto receivedPredicateIds = gatedPlanner->GetReceivedPredicateIds();
+
+	ASSERT_EQ(receivedPredicateIds.size(), 1);
+	ASSERT_EQ(receivedPredicateIds[0], std::vector<int>({ 1, 2 }));
+	ASSERT_TRUE(search->IsFinished());
+	ASSERT_TRUE(search->GetBestPlan() != nullptr);
+	ASSERT_EQ(search->GetBestPlan()->GetCost(), 1);
+}
+
+TEST(NAI_AsyncGoapPlanner, When_ManyRequests_Then_AllOfThemAreDispatched)
+{
+	auto planner = std::make_shared<AsyncGoapPlanner>(std::make_shared<TreeGoapPlanner>(), 4);
+
+	const auto numRequests = 32;
+	std::vector<std::shared_ptr<IGoal>> expectedPlans;
+	std::vector<std::shared_ptr<IPlanningSearch>> searches;
+	for (auto i = 0; i < numRequests; ++i)
+	{
+		auto predicateA = std::make_shared<BasePredicate>(1, "A");
+		auto predicateB = std::make_shared<BasePredicate>(2, "B");
+		auto goals = CreateTwoGoalsWithDifferentCost(predicateA, predicateB);
+		expectedPlans.push_back(goals[1]);
+
+		std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+		searches.push_back(planner->GetPlan(goals, predicates, PlanningBudget::Unlimited()));
+	}
+
+	planner->WaitForAll();
+	ASSERT_EQ(planner->DispatchCompletedPlans(), numRequests);
+
+	for (auto i = 0; i < numRequests; ++i)
+	{
+		ASSERT_TRUE(searches[i]->IsFinished());
+		ASSERT_TRUE(searches[i]->GetBestPlan() == expectedPlans[i]);
+	}
+}
+
+TEST(NAI_AsyncGoapPlanner, When_AgentPlansAsynchronously_Then_KeepsPlanningUntilThePlanArrives)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+
+	std::vector<std::string> preconditions = { predicateA->GetText() };
+	std::vector<std::shared_ptr<IPredicate>> postconditions = { predicateB };
+	std::vector<std::shared_ptr<IAction>> actions = { std::make_shared<BaseAction>(preconditions, postconditions) };
+
+	auto planner = std::make_shared<AsyncGoapPlanner>(std::make_shared<TreeGoapPlanner>(), 2);
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(planner)
+								.WithGoal(std::make_shared<BaseGoal>(actions))
+								.WithPredicate(predicateA)
+								.WithPlanningBudget(PlanningBudget::Unlimited())
+								.Build<AsyncAgentMock>();
+
+	agent->Update(0.0f); //requests the plan
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PLANNING);
+
+	planner->WaitForAll();
+	agent->Update(0.0f); //the plan is done but not dispatched yet
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PLANNING);
+
+	planner->DispatchCompletedPlans();
+	agent->Update(0.0f);
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PROCESSING);
+}
+
+TEST(NAI_AsyncGoapPlanner, When_AgentIsProcessingAndReplans_Then_KeepsProcessingUntilTheNewPlanArrives)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	std::vector<std::shared_ptr<IAction>> actions = {
+		CreateActionWith({ predicateA->GetText() }, { predicateB }, 1),
+		CreateActionWith({ predicateB->GetText() }, { predicateC }, 1) };
+
+	auto planner = std::make_shared<AsyncGoapPlanner>(std::make_shared<TreeGoapPlanner>(), 2);
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(planner)
+								.WithGoal(std::make_shared<BaseGoal>(actions))
+								.WithPredicate(predicateA)
+								.WithPlanningBudget(PlanningBudget::Unlimited())
+								.Build<AsyncAgentMock>();
+
+	agent->Update(0.0f); //requests the plan
+	planner->WaitForAll();
+	planner->DispatchCompletedPlans();
+	agent->Update(0.0f);
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PROCESSING);
+
+	agent->OnNewPredicate(std::make_shared<BasePredicate>(4, "D"));
+
+	agent->Update(0.0f); //requests a new plan and keeps processing the first action meanwhile
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PROCESSING);
+	ASSERT_TRUE(agent->HasPredicate(predicateB->GetID()));
+	ASSERT_EQ(planner->GetNumPendingRequests(), 1);
+
+	planner->WaitForAll();
+	planner->DispatchCompletedPlans();
+	agent->Update(0.0f); //takes the new plan
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PROCESSING);
+	ASSERT_EQ(planner->GetNumPendingRequests(), 0);
+}
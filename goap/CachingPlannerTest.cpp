@@ -0,0 +1,297 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "goap/planners/CachingGoapPlanner.h"
+#include "goap/planners/PlanCache.h"
+#include "goap/planners/TreeGoapPlanner.h"
+#include "goap/IGoapPlanner.h"
+#include "goap/BaseGoal.h"
+#include "goap/BaseAction.h"
+#include "goap/BasePredicate.h"
+#include "goap/predicates/GoToPredicate.h"
+#include "goap/goals/GoToGoal.h"
+#include "GoapTestUtils.h"
+
+#include <memory>
+#include <vector>
+
+using namespace NAI::Goap;
+using ::testing::NiceMock;
+using ::testing::_;
+
+class FirstGoalGoapPlannerMock : public IGoapPlanner
+{
+public:
+	FirstGoalGoapPlannerMock()
+	{
+		ON_CALL(*this, GetPlan).WillByDefault(
+			[this](std::vector<std::shared_ptr<IGoal>>& goals, std::vector<std::shared_ptr<IPredicate>>& predicates)
+			{
+				return goals.empty() ? nullptr : goals[0];
+			});
+
+		ON_CALL(*this, GetPlanToReach).WillByDefault(
+			[this](
+				std::vector<std::shared_ptr<IGoal>>& goals,
+				std::vector<std::shared_ptr<IPredicate>>& predicates,
+				std::vector<std::shared_ptr<IPredicate>>& desiredPredicates)
+			{
+				return goals;
+			});
+	}
+	virtual ~FirstGoalGoapPlannerMock() = default;
+
+	MOCK_CONST_METHOD2(GetPlan,
+		std::shared_ptr<IGoal>(
+			std::vector<std::shared_ptr<IGoal>>&,
+			std::vector<std::shared_ptr<IPredicate>>&));
+	MOCK_CONST_METHOD3(GetPlanToReach,
+		std::vector<std::shared_ptr<IGoal>>(
+			std::vector<std::shared_ptr<IGoal>>&,
+			std::vector<std::shared_ptr<IPredicate>>&,
+			std::vector<std::shared_ptr<IPredicate>>&));
+};
+
+//Agents of the same type share a goal set id, so they can share plans
+static const unsigned int WORKER_GOAL_SET_ID = 1;
+static const unsigned int SOLDIER_GOAL_SET_ID = 2;
+
+static std::vector<std::shared_ptr<IGoal>> CreateOneActionGoals()
+{
+	std::vector<std::string> preconditions = { "A" };
+	std::vector<std::shared_ptr<IPredicate>> postconditions = { std::make_shared<BasePredicate>(2, "B") };
+	std::vector<std::shared_ptr<IAction>> actions;
+	actions.push_back(std::make_shared<BaseAction>(preconditions, postconditions, 1));
+
+	return { std::make_shared<BaseGoal>(actions) };
+}
+
+TEST(NAI_CachingGoapPlanner, When_FirstPlan_Then_Miss)
+{
+	const auto plannerMock = std::make_shared<NiceMock<FirstGoalGoapPlannerMock>>();
+	const auto cache = std::make_shared<PlanCache>(16);
+	const auto planner = std::make_shared<CachingGoapPlanner>(plannerMock, cache, WORKER_GOAL_SET_ID);
+
+	auto goals = CreateOneActionGoals();
+	std::vector<std::shared_ptr<IPredicate>> predicates = { std::make_shared<BasePredicate>(1, "A") };
+
+	EXPECT_CALL(*plannerMock, GetPlan(_, _)).Times(1);
+
+	const auto plan = planner->GetPlan(goals, predicates);
+
+	ASSERT_TRUE(plan != nullptr);
+	ASSERT_EQ(cache->GetNumMisses(), 1);
+	ASSERT_EQ(cache->GetNumHits(), 0);
+	ASSERT_EQ(cache->GetSize(), 1);
+}
+
+TEST(NAI_CachingGoapPlanner, When_TwoAgentsWithSameGoalSetAndPredicates_Then_PlanIsComputedOnce)
+{
+	const auto plannerMock = std::make_shared<NiceMock<FirstGoalGoapPlannerMock>>();
+	const auto cache = std::make_shared<PlanCache>(16);
+	const auto plannerAgent1 = std::make_shared<CachingGoapPlanner>(plannerMock, cache, WORKER_GOAL_SET_ID);
+	const auto plannerAgent2 = std::make_shared<CachingGoapPlanner>(plannerMock, cache, WORKER_GOAL_SET_ID);
+
+	auto goalsAgent1 = CreateOneActionGoals();
+	auto goalsAgent2 = CreateOneActionGoals();
+	std::vector<std::shared_ptr<IPredicate>> predicatesAgent1 = { std::make_shared<BasePredicate>(1, "A") };
+	std::vector<std::shared_ptr<IPredicate>> predicatesAgent2 = { std::make_shared<BasePredicate>(1, "A") };
+
+	EXPECT_CALL(*plannerMock, GetPlan(_, _)).Times(1);
+
+	const auto plan1 = plannerAgent1->GetPlan(goalsAgent1, predicatesAgent1);
+	const auto plan2 = plannerAgent2->GetPlan(goalsAgent2, predicatesAgent2);
+
+	ASSERT_EQ(cache->GetNumMisses(), 1);
+	ASSERT_EQ(cache->GetNumHits(), 1);
+	ASSERT_TRUE(plan1 != nullptr);
+	ASSERT_TRUE(plan2 != nullptr);
+}
+
+TEST(NAI_CachingGoapPlanner, When_TwoAgentsWithDifferentGoalSetsAndSamePredicates_Then_Miss)
+{
+	const auto plannerMock = std::make_shared<NiceMock<FirstGoalGoapPlannerMock>>();
+	const auto cache = std::make_shared<PlanCache>(16);
+	const auto workerPlanner = std::make_shared<CachingGoapPlanner>(plannerMock, cache, WORKER_GOAL_SET_ID);
+	const auto soldierPlanner = std::make_shared<CachingGoapPlanner>(plannerMock, cache, SOLDIER_GOAL_SET_ID);
+
+	//same shape of goals, but they belong to different goal sets
+	auto workerGoals = CreateOneActionGoals();
+	auto soldierGoals = CreateOneActionGoals();
+	std::vector<std::shared_ptr<IPredicate>> predicates = { std::make_shared<BasePredicate>(1, "A") };
+
+	EXPECT_CALL(*plannerMock, GetPlan(_, _)).Times(2);
+
+	const auto workerPlan = workerPlanner->GetPlan(workerGoals, predicates);
+	const auto soldierPlan = soldierPlanner->GetPlan(soldierGoals, predicates);
+
+	ASSERT_TRUE(workerPlan == workerGoals[0]);
+	ASSERT_TRUE(soldierPlan == soldierGoals[0]);
+	ASSERT_EQ(cache->GetNumMisses(), 2);
+	ASSERT_EQ(cache->GetNumHits(), 0);
+	ASSERT_EQ(cache->GetSize(), 2);
+}
+
+TEST(NAI_CachingGoapPlanner, When_CachedPlanIsReturned_Then_ItIsBoundToTheCallerGoals)
+{
+	const auto plannerMock = std::make_shared<NiceMock<FirstGoalGoapPlannerMock>>();
+	const auto cache = std::make_shared<PlanCache>(16);
+	const auto plannerAgent1 = std::make_shared<CachingGoapPlanner>(plannerMock, cache, WORKER_GOAL_SET_ID);
+	const auto plannerAgent2 = std::make_shared<CachingGoapPlanner>(plannerMock, cache, WORKER_GOAL_SET_ID);
+
+	auto goalsAgent1 = CreateOneActionGoals();
+	auto goalsAgent2 = CreateOneActionGoals();
+	std::vector<std::shared_ptr<IPredicate>> predicates = { std::make_shared<BasePredicate>(1, "A") };
+
+	const auto plan1 = plannerAgent1->GetPlan(goalsAgent1, predicates);
+	const auto plan2 = plannerAgent2->GetPlan(goalsAgent2, predicates);
+
+	ASSERT_TRUE(plan1 == goalsAgent1[0]);
+	ASSERT_TRUE(plan2 == goalsAgent2[0]);
+
+	//consuming the plan of one agent doesn't change the plan of the other one
+	ASSERT_TRUE(plan1->GetNextAction() != nullptr);
+	ASSERT_TRUE(plan1->GetNextAction() == nullptr);
+	ASSERT_TRUE(plan2->GetNextAction() != nullptr);
+}
+
+TEST(NAI_CachingGoapPlanner, When_PredicatesAreDifferent_Then_Miss)
+{
+	const auto plannerMock = std::make_shared<NiceMock<FirstGoalGoapPlannerMock>>();
+	const auto cache = std::make_shared<PlanCache>(16);
+	const auto planner = std::make_shared<CachingGoapPlanner>(plannerMock, cache, WORKER_GOAL_SET_ID);
+
+	auto goals = CreateOneActionGoals();
+	std::vector<std::shared_ptr<IPredicate>> predicates1 = { std::make_shared<BasePredicate>(1, "A") };
+	std::vector<std::shared_ptr<IPredicate>> predicates2 = { std::make_shared<BasePredicate>(1, "A"), std::make_shared<BasePredicate>(3, "C") };
+
+	EXPECT_CALL(*plannerMock, GetPlan(_, _)).Times(2);
+
+	planner->GetPlan(goals, predicates1);
+	planner->GetPlan(goals, predicates2);
+
+	ASSERT_EQ(cache->GetNumMisses(), 2);
+	ASSERT_EQ(cache->GetNumHits(), 0);
+}
+
+TEST(NAI_CachingGoapPlanner, When_PredicatesOnlyDifferInTheirData_Then_Miss)
+{
+	const auto plannerMock = std::make_shared<NiceMock<FirstGoalGoapPlannerMock>>();
+	const auto cache = std::make_shared<PlanCache>(16);
+	const auto planner = std::make_shared<CachingGoapPlanner>(plannerMock, cache, WORKER_GOAL_SET_ID);
+
+	auto goals = CreateOneActionGoals();
+	//same id and text, the place is the only difference
+	std::vector<std::shared_ptr<IPredicate>> predicatesSaloon = { std::make_shared<GoToPredicate>(1, PREDICATE_GO_TO_NAME, "Saloon") };
+	std::vector<std::shared_ptr<IPredicate>> predicatesGeneralStore = { std::make_shared<GoToPredicate>(1, PREDICATE_GO_TO_NAME, "GeneralStore") };
+
+	EXPECT_CALL(*plannerMock, GetPlan(_, _)).Times(2);
+
+	planner->GetPlan(goals, predicatesSaloon);
+	planner->GetPlan(goals, predicatesGeneralStore);
+
+	ASSERT_EQ(cache->GetNumMisses(), 2);
+	ASSERT_EQ(cache->GetNumHits(), 0);
+	ASSERT_EQ(cache->GetSize(), 2);
+}
+
+TEST(NAI_CachingGoapPlanner, When_CacheIsFull_Then_LeastRecentlyUsedIsEvicted)
+{
+	const auto plannerMock = std::make_shared<NiceMock<FirstGoalGoapPlannerMock>>();
+	const auto cache = std::make_shared<PlanCache>(2);
+	const auto planner = std::make_shared<CachingGoapPlanner>(plannerMock, cache, WORKER_GOAL_SET_ID);
+
+	auto goals = CreateOneActionGoals();
+	std::vector<std::shared_ptr<IPredicate>> predicatesA = { std::make_shared<BasePredicate>(1, "A") };
+	std::vector<std::shared_ptr<IPredicate>> predicatesB = { std::make_shared<BasePredicate>(1, "A"), std::make_shared<BasePredicate>(2, "B") };
+	std::vector<std::shared_ptr<IPredicate>> predicatesC = { std::make_shared<BasePredicate>(1, "A"), std::make_shared<BasePredicate>(3, "C") };
+
+	planner->GetPlan(goals, predicatesA);
+	planner->GetPlan(goals, predicatesB);
+	planner->GetPlan(goals, predicatesA); //A is now the most recently used
+	planner->GetPlan(goals, predicatesC); //evicts B
+
+	ASSERT_EQ(cache->GetSize(), 2);
+	ASSERT_EQ(cache->GetNumHits(), 1);
+
+	planner->GetPlan(goals, predicatesA);
+	ASSERT_EQ(cache->GetNumHits(), 2);
+
+	planner->GetPlan(goals, predicatesB);
+	ASSERT_EQ(cache->GetNumHits(), 2);
+	ASSERT_EQ(cache->GetNumMisses(), 4);
+}
+
+TEST(NAI_CachingGoapPlanner, When_DecoratingTreeGoapPlanner_Then_SameLessCostPlan)
+{
+	const auto cache = std::make_shared<PlanCache>(16);
+	const auto planner = std::make_shared<CachingGoapPlanner>(std::make_shared<TreeGoapPlanner>(), cache, WORKER_GOAL_SET_ID);
+
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	std::vector<std::shared_ptr<IGoal>> goals;
+	std::vector<std::shared_ptr<IAction>> actions = { CreateActionWith({ predicateB->GetText() }, { predicateC }, 3) };
+	goals.push_back(std::make_shared<BaseGoal>(actions));
+	actions = { CreateActionWith({ predicateA->GetText() }, { predicateC }, 1) };
+	goals.push_back(std::make_shared<BaseGoal>(actions));
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+
+	const auto plan = planner->GetPlan(goals, predicates);
+	const auto cachedPlan = planner->GetPlan(goals, predicates);
+
+	ASSERT_TRUE(plan != nullptr);
+	ASSERT_EQ(plan->GetCost(), 1);
+	ASSERT_TRUE(cachedPlan == plan);
+	ASSERT_EQ(cache->GetNumHits(), 1);
+}
+
+//A cheap goal with two actions A->B->C and an expensive one with a single action A->C
+static std::vector<std::shared_ptr<IGoal>> CreateTwoStepsAndOneStepGoals(const std::shared_ptr<IPredicate>& predicateA)
+{
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	std::vector<std::shared_ptr<IGoal>> goals;
+	std::vector<std::shared_ptr<IAction>> actions = {
+		CreateActionWith({ predicateA->GetText() }, { predicateB }, 1),
+		CreateActionWith({ predicateB->GetText() }, { predicateC }, 1) };
+	goals.push_back(std::make_shared<BaseGoal>(actions));
+
+	actions = { CreateActionWith({ predicateA->GetText() }, { predicateC }, 5) };
+	goals.push_back(std::make_shared<BaseGoal>(actions));
+
+	return goals;
+}
+
+TEST(NAI_CachingGoapPlanner, When_DecoratingTreeGoapPlannerAndPlanIsCached_Then_ItIsBoundToTheCallerGoals)
+{
+	const auto cache = std::make_shared<PlanCache>(16);
+	const auto treePlanner = std::make_shared<TreeGoapPlanner>();
+	const auto plannerAgent1 = std::make_shared<CachingGoapPlanner>(treePlanner, cache, WORKER_GOAL_SET_ID);
+	const auto plannerAgent2 = std::make_shared<CachingGoapPlanner>(treePlanner, cache, WORKER_GOAL_SET_ID);
+
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto goalsAgent1 = CreateTwoStepsAndOneStepGoals(predicateA);
+	auto goalsAgent2 = CreateTwoStepsAndOneStepGoals(predicateA);
+	std::vector<std::shared_ptr<IPredicate>> predicatesAgent1 = { predicateA };
+	std::vector<std::shared_ptr<IPredicate>> predicatesAgent2 = { predicateA };
+
+	const auto plan1 = plannerAgent1->GetPlan(goalsAgent1, predicatesAgent1);
+	const auto plan2 = plannerAgent2->GetPlan(goalsAgent2, predicatesAgent2);
+
+	ASSERT_EQ(cache->GetNumMisses(), 1);
+	ASSERT_EQ(cache->GetNumHits(), 1);
+	ASSERT_TRUE(plan1 == goalsAgent1[0]);
+	ASSERT_TRUE(plan2 == goalsAgent2[0]);
+
+	//the first agent goes through its whole plan while the second one hasn't started yet
+	ASSERT_TRUE(plan1->GetNextAction() != nullptr);
+	ASSERT_TRUE(plan1->GetNextAction() != nullptr);
+	ASSERT_TRUE(plan1->GetNextAction() == nullptr);
+
+	ASSERT_TRUE(plan2->GetNextAction() != nullptr);
+	ASSERT_TRUE(plan2->GetNextAction() != nullptr);
+	ASSERT_TRUE(plan2->GetNextAction() == nullptr);
+}
@@ -146,6 +146,7 @@ public:
 		ON_CALL(*this, GetAproxCost).WillByDefault(
 			[this](const glm::vec3& origin, const glm::vec3& destination)
 			{
+				++mNumAproxCosts;
 				if (destination == glm::vec3(7, 1, 10))
 				{
 					return 3;
@@ -163,8 +164,12 @@ public:
 	MOCK_CONST_METHOD2(GetAproxCost, unsigned int(const glm::vec3&, const glm::vec3&));
 	MOCK_CONST_METHOD3(GetRandomReachablePointInRadius, bool(const glm::vec3&, float, glm::vec3&));
 
+	unsigned int GetNumAproxCosts() const { return mNumAproxCosts; }
+	void ResetNumAproxCosts() { mNumAproxCosts = 0; }
+
 private:
 	std::vector<glm::vec3> mPath;
+	mutable unsigned int mNumAproxCosts = 0;
 };
 
 class GoToGoalMock : public GoToGoal
@@ -542,3 +547,99 @@ TEST(NAI_GoToGoalTest, When_AgentHasToGoAndNewPredicates_Then_IsNotAccumulatingG
 	ASSERT_TRUE(agent->WhereIam() == destinationPlaceName);
 	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PLANNING);
 }
+
+#ifdef NAI_NEXT_API
+TEST(NAI_GoToGoalTest, When_PlanRepairAndAgentHasToGoAndNewPredicate_Then_DoesNotAbortAndArrives)
+{
+	std::vector<glm::vec3> path;
+	path.emplace_back(glm::vec3(0, 0, 5));
+	path.emplace_back(glm::vec3(5, 0, 5));
+	path.emplace_back(glm::vec3(5, 0, 10));
+	
+	const auto goapPlanner = std::make_shared<NiceMock<TreeGoapPlanner>>();
+	auto navigationPlanner = std::make_shared<NiceMock<NavigationPlannerMock>>(path);
+
+	std::string destinationPlaceName("Saloon");
+	const auto goal = std::make_shared<NiceMock<GoToGoalMock>>(navigationPlanner);
+	
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(goapPlanner)
+			                                .WithGoal(goal)
+			                                .WithPredicate(std::make_shared<GoToPredicate>(1, PREDICATE_GO_TO_NAME, destinationPlaceName))
+			                                .WithPlanRepair(true)
+			                                .Build<AgentWalkerMock>();
+	auto agentWalker = std::static_pointer_cast<AgentWalkerMock>(agent);
+	
+	const glm::vec3 originPoint(0.0f);
+	const auto speed = 10.f;
+	agentWalker->SetParameters(originPoint, speed);
+	
+	agent->StartUp();
+
+	for (auto i = 0; i < 73; ++i)
+	{
+		agent->Update(0.016f);
+	}
+	ASSERT_TRUE(agent->GetPosition() == glm::vec3(5.0f, 0.0f, 5.63999939f));
+	EXPECT_CALL(*goal, DoCancel).Times(0);
+
+	agent->OnNewPredicate(std::make_shared<BasePredicate>(2, "NewPredicate"));
+	agent->Update(0.016f);
+
+	//the agent kept walking instead of planning again
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PROCESSING);
+	ASSERT_FALSE(agent->GetPosition() == glm::vec3(5.0f, 0.0f, 5.63999939f));
+
+	for (auto i = 0; i < 66; ++i)
+	{
+		agent->Update(0.016f);
+	}
+
+	glm::vec3 destination;
+	navigationPlanner->FillWithLocationGivenAName(destinationPlaceName, destination);
+	
+	ASSERT_TRUE(glm::distance(agent->GetPosition(), destination) < MOVEMENT_PRECISION);
+	ASSERT_TRUE(agent->WhereIam() == destinationPlaceName);
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PLANNING);
+	ASSERT_TRUE(agent->GetPredicates().size() == 2);
+}
+
+TEST(NAI_GoToGoalTest, When_GettingCostsOfCandidatesGoingToTheSamePlace_Then_LessNavigationQueriesThanOneByOne)
+{
+	std::vector<glm::vec3> path;
+	path.emplace_back(glm::vec3(0, 0, 5));
+
+	auto navigationPlanner = std::make_shared<NiceMock<NavigationPlannerMock>>(path);
+	const auto goal = std::make_shared<NiceMock<GoToGoalMock>>(navigationPlanner);
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(std::make_shared<NiceMock<TreeGoapPlanner>>())
+								.WithGoal(goal)
+								.Build<AgentWalkerMock>();
+	std::static_pointer_cast<AgentWalkerMock>(agent)->SetParameters(glm::vec3(0.0f), 10.0f);
+	agent->StartUp();
+
+	std::vector<std::shared_ptr<IPredicate>> inputPredicates;
+	const std::vector<std::vector<std::shared_ptr<IPredicate>>> candidates = {
+		{ std::make_shared<GoToPredicate>(1, PREDICATE_GO_TO_NAME, "Saloon") },
+		{ std::make_shared<GoToPredicate>(2, PREDICATE_GO_TO_NAME, "GeneralStore") },
+		{ std::make_shared<GoToPredicate>(3, PREDICATE_GO_TO_NAME, "Saloon") }
+	};
+
+	navigationPlanner->ResetNumAproxCosts();
+	std::vector<unsigned int> costsOneByOne;
+	for (auto&& candidate : candidates)
+	{
+		auto accomplishedPredicates = candidate;
+		costsOneByOne.push_back(goal->GetCost(inputPredicates, accomplishedPredicates));
+	}
+	const auto numAproxCostsOneByOne = navigationPlanner->GetNumAproxCosts();
+
+	navigationPlanner->ResetNumAproxCosts();
+	const auto costs = goal->GetCosts(inputPredicates, candidates);
+
+	ASSERT_EQ(costs, costsOneByOne);
+	//two candidates go to the same place, and the batch only asks once for it
+	ASSERT_LT(navigationPlanner->GetNumAproxCosts(), numAproxCostsOneByOne);
+}
+#endif
@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "goap/GoalCostMemo.h"
+#include "goap/BaseGoal.h"
+#include "goap/BasePredicate.h"
+#include "goap/PredicatesHandler.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace NAI::Goap;
+using ::testing::NiceMock;
+using ::testing::_;
+
+class CostGoalMock : public BaseGoal
+{
+public:
+	CostGoalMock(unsigned int cost) : mCost{ cost }
+	{
+		ON_CALL(*this, GetCost(_, _)).WillByDefault(
+			[this](std::vector<std::shared_ptr<IPredicate>>& inputPredicates, std::vector<std::shared_ptr<IPredicate>>& accomplishedPredicates)
+			{
+				return mCost;
+			});
+	}
+	virtual ~CostGoalMock() = default;
+
+	MOCK_CONST_METHOD2(GetCost, unsigned int(std::vector<std::shared_ptr<IPredicate>>&, std::vector<std::shared_ptr<IPredicate>>&));
+
+private:
+	unsigned int mCost;
+};
+
+//Predicate whose payload changes while its id and text stay the same
+class StockPredicate : public BasePredicate
+{
+public:
+	StockPredicate(int id, const std::string& text, unsigned int stock) : BasePredicate(id, text), mStock{ stock } {}
+	virtual ~StockPredicate() = default;
+
+	unsigned int GetStock() const { return mStock; }
+
+private:
+	unsigned int mStock;
+};
+
+class StockCostGoal : public BaseGoal
+{
+public:
+	StockCostGoal() = default;
+	virtual ~StockCostGoal() = default;
+
+	unsigned int GetCost(std::vector<std::shared_ptr<IPredicate>>& inputPredicates, std::vector<std::shared_ptr<IPredicate>>& accomplishedPredicates) const override
+	{
+		return std::static_pointer_cast<StockPredicate>(inputPredicates[0])->GetStock();
+	}
+};
+
+TEST(NAI_GoalCostMemo, When_SameGoalAndPredicatesInTheSameVersion_Then_CostIsComputedOnce)
+{
+	GoalCostMemo memo;
+	const auto goal = std::make_shared<NiceMock<CostGoalMock>>(7);
+
+	const std::vector<std::shared_ptr<IPredicate>> inputPredicates = { std::make_shared<BasePredicate>(1, "A") };
+	const std::vector<std::shared_ptr<IPredicate>> accomplishedPredicates = { std::make_shared<BasePredicate>(2, "B") };
+
+	EXPECT_CALL(*goal, GetCost(_, _)).Times(1);
+
+	ASSERT_EQ(memo.GetCost(goal, inputPredicates, accomplishedPredicates, 1), 7);
+	ASSERT_EQ(memo.GetCost(goal, inputPredicates, accomplishedPredicates, 1), 7);
+	ASSERT_EQ(memo.GetNumMisses(), 1);
+	ASSERT_EQ(memo.GetNumHits(), 1);
+}
+
+TEST(NAI_GoalCostMemo, When_AccomplishedPredicatesHaveTheSameIds_Then_CostIsReused)
+{
+	GoalCostMemo memo;
+	const auto goal = std::make_shared<NiceMock<CostGoalMock>>(7);
+
+	const std::vector<std::shared_ptr<IPredicate>> inputPredicates;
+	const std::vector<std::shared_ptr<IPredicate>> accomplishedPredicates1 = { std::make_shared<BasePredicate>(2, "B") };
+	const std::vector<std::shared_ptr<IPredicate>> accomplishedPredicates2 = { std::make_shared<BasePredicate>(2, "B") };
+
+	EXPECT_CALL(*goal, GetCost(_, _)).Times(1);
+
+	memo.GetCost(goal, inputPredicates, accomplishedPredicates1, 1);
+	memo.GetCost(goal, inputPredicates, accomplishedPredicates2, 1);
+}
+
+TEST(NAI_GoalCostMemo, When_DifferentGoalsOrAccomplishedPredicates_Then_CostIsComputedForEach)
+{
+	GoalCostMemo memo;
+	const auto goal1 = std::make_shared<NiceMock<CostGoalMock>>(3);
+	const auto goal2 = std::make_shared<NiceMock<CostGoalMock>>(5);
+
+	const std::vector<std::shared_ptr<IPredicate>> inputPredicates;
+	const std::vector<std::shared_ptr<IPredicate>> accomplishedPredicatesB = { std::make_shared<BasePredicate>(2, "B") };
+	const std::vector<std::shared_ptr<IPredicate>> accomplishedPredicatesC = { std::make_shared<BasePredicate>(3, "C") };
+
+	EXPECT_CALL(*goal1, GetCost(_, _)).Times(2);
+	EXPECT_CALL(*goal2, GetCost(_, _)).Times(1);
+
+	ASSERT_EQ(memo.GetCost(goal1, inputPredicates, accomplishedPredicatesB, 1), 3);
+	ASSERT_EQ(memo.GetCost(goal1, inputPredicates, accomplishedPredicatesC, 1), 3);
+	ASSERT_EQ(memo.GetCost(goal2, inputPredicates, accomplishedPredicatesB, 1), 5);
+	ASSERT_EQ(memo.GetSize(), 3);
+}
+
+TEST(NAI_GoalCostMemo, When_PredicatesVersionChanges_Then_MemoIsInvalidated)
+{
+	GoalCostMemo memo;
+	const auto goal = std::make_shared<NiceMock<CostGoalMock>>(7);
+
+	const std::vector<std::shared_ptr<IPredicate>> inputPredicates;
+	const std::vector<std::shared_ptr<IPredicate>> accomplishedPredicates = { std::make_shared<BasePredicate>(2, "B") };
+
+	EXPECT_CALL(*goal, GetCost(_, _)).Times(2);
+
+	memo.GetCost(goal, inputPredicates, accomplishedPredicates, 1);
+	memo.GetCost(goal, inputPredicates, accomplishedPredicates, 2);
+
+	ASSERT_EQ(memo.GetNumMisses(), 2);
+	ASSERT_EQ(memo.GetSize(), 1);
+}
+
+TEST(NAI_GoalCostMemo, When_APredicatePayloadChanges_Then_CostIsComputedAgain)
+{
+	GoalCostMemo memo;
+	PredicatesHandler predicatesHandler;
+	const auto goal = std::make_shared<StockCostGoal>();
+
+	const std::vector<std::shared_ptr<IPredicate>> accomplishedPredicates = { std::make_shared<BasePredicate>(2, "B") };
+
+	predicatesHandler.AddOrReplace(std::make_shared<StockPredicate>(1, "STOCK", 5));
+	ASSERT_EQ(memo.GetCost(goal, predicatesHandler.GetPredicatesList(), accomplishedPredicates, predicatesHandler.GetVersion()), 5);
+
+	//same id and text, only the payload changes
+	predicatesHandler.AddOrReplace(std::make_shared<StockPredicate>(1, "STOCK", 9));
+	ASSERT_EQ(memo.GetCost(goal, predicatesHandler.GetPredicatesList(), accomplishedPredicates, predicatesHandler.GetVersion()), 9);
+
+	ASSERT_EQ(memo.GetNumMisses(), 2);
+	ASSERT_EQ(memo.GetNumHits(), 0);
+}
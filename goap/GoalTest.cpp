@@ -0,0 +1,217 @@
+#include "gtest/gtest.h"
+#include "goap/IGoal.h"
+#include "goap/BaseGoal.h"
+#include "goap/IAction.h"
+#include "goap/BaseAction.h"
+#include "goap/IPredicate.h"
+#include "goap/BasePredicate.h"
+#include "goap/agent/BaseAgent.h"
+#include "goap/agent/AgentBuilder.h"
+#include "goap/planners/TreeGoapPlanner.h"
+
+#include <memory>
+#include <vector>
+
+using namespace NAI::Goap;
+
+class ResettableGoal : public BaseGoal
+{
+public:
+	ResettableGoal() = default;
+	virtual ~ResettableGoal() = default;
+
+	void SetNextPostcondition(const std::string& text) { mNextPostcondition = text; }
+
+protected:
+	void DoReset(std::vector<std::shared_ptr<IPredicate>>& predicates) override
+	{
+		mActions.clear();
+
+		std::vector<std::string> preConditions = { "A" };
+		std::vector<std::shared_ptr<IPredicate>> postConditions = { std::make_shared<BasePredicate>(10, mNextPostcondition) };
+		mActions.push_back(std::make_shared<BaseAction>(preConditions, postConditions));
+	}
+
+private:
+	std::string mNextPostcondition;
+};
+
+//Builds its actions when the agent creates it, as the chicken goals do
+class CreatedGoal : public BaseGoal
+{
+public:
+	CreatedGoal() = default;
+	virtual ~CreatedGoal() = default;
+
+	void DoCreate(const std::shared_ptr<IAgent>& agent) override
+	{
+		std::vector<std::string> preConditions = { "FOOD" };
+		std::vector<std::shared_ptr<IPredicate>> postConditions = { std::make_shared<BasePredicate>(10, "FULL") };
+		mActions.push_back(std::make_shared<BaseAction>(preConditions, postConditions));
+	}
+};
+
+class GoalOwnerAgentMock : public BaseAgent
+{
+public:
+	GoalOwnerAgentMock(const std::shared_ptr<IGoapPlanner> goapPlanner,
+		const std::vector<std::shared_ptr<IGoal>>& goals,
+		const std::vector<std::shared_ptr<IPredicate>>& predicates) :
+	GoalOwnerAgentMock(goapPlanner, goals, predicates, nullptr)
+	{
+	}
+
+	GoalOwnerAgentMock(const std::shared_ptr<IGoapPlanner> goapPlanner,
+		const std::vector<std::shared_ptr<IGoal>>& goals,
+		const std::vector<std::shared_ptr<IPredicate>>& predicates,
+		const std::shared_ptr<PerceptionSystem> perceptionSystem) :
+	BaseAgent(goapPlanner, goals, predicates, perceptionSystem)
+	{
+	}
+
+	virtual ~GoalOwnerAgentMock() = default;
+
+	glm::vec3 GetPosition() const override { return glm::vec3(0.0f); }
+	void MoveTo(float elapsedTime, const glm::vec3& point) override {}
+};
+
+class AmountCostGoal : public BaseGoal
+{
+public:
+	AmountCostGoal() = default;
+	virtual ~AmountCostGoal() = default;
+
+	unsigned int GetCost(std::vector<std::shared_ptr<IPredicate>>& inputPredicates, std::vector<std::shared_ptr<IPredicate>>& accomplishedPredicates) const override
+	{
+		return static_cast<unsigned int>(inputPredicates.size() + accomplishedPredicates.size() * 10);
+	}
+};
+
+TEST(NAI_Goal, When_ActionProducesAPredicate_Then_ItIsFoundByThatPredicate)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	std::vector<std::string> preconditions = { predicateA->GetText() };
+	std::vector<std::shared_ptr<IPredicate>> postconditions = { predicateB };
+	const auto action1 = std::make_shared<BaseAction>(preconditions, postconditions);
+
+	preconditions = { predicateB->GetText() };
+	postconditions = { predicateC };
+	const auto action2 = std::make_shared<BaseAction>(preconditions, postconditions);
+
+	std::vector<std::shared_ptr<IAction>> actions = { action1, action2 };
+	const auto goal = std::make_shared<BaseGoal>(actions);
+
+	const auto& producersOfB = goal->GetActionsProducing(predicateB->GetText());
+	const auto& producersOfC = goal->GetActionsProducing(predicateC->GetText());
+
+	ASSERT_EQ(producersOfB.size(), 1);
+	ASSERT_TRUE(producersOfB[0] == action1);
+	ASSERT_EQ(producersOfC.size(), 1);
+	ASSERT_TRUE(producersOfC[0] == action2);
+}
+
+TEST(NAI_Goal, When_NoActionProducesAPredicate_Then_Empty)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+
+	std::vector<std::string> preconditions = { predicateA->GetText() };
+	std::vector<std::shared_ptr<IPredicate>> postconditions = { predicateB };
+	std::vector<std::shared_ptr<IAction>> actions = { std::make_shared<BaseAction>(preconditions, postconditions) };
+	const auto goal = std::make_shared<BaseGoal>(actions);
+
+	ASSERT_TRUE(goal->GetActionsProducing(predicateA->GetText()).empty());
+	ASSERT_TRUE(goal->GetActionsProducing("not a postcondition").empty());
+}
+
+TEST(NAI_Goal, When_SomeActionsProduceTheSamePredicate_Then_AllOfThemAreFoundInOrder)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	std::vector<std::string> preconditions = { predicateA->GetText() };
+	std::vector<std::shared_ptr<IPredicate>> postconditions = { predicateC };
+	const auto action1 = std::make_shared<BaseAction>(preconditions, postconditions, 2);
+
+	preconditions = { predicateB->GetText() };
+	const auto action2 = std::make_shared<BaseAction>(preconditions, postconditions, 1);
+
+	std::vector<std::shared_ptr<IAction>> actions = { action1, action2 };
+	const auto goal = std::make_shared<BaseGoal>(actions);
+
+	const auto& producers = goal->GetActionsProducing(predicateC->GetText());
+
+	ASSERT_EQ(producers.size(), 2);
+	ASSERT_TRUE(producers[0] == action1);
+	ASSERT_TRUE(producers[1] == action2);
+}
+
+TEST(NAI_Goal, When_ResetRebuildsTheActions_Then_ProducersAreUpdated)
+{
+	const auto goal = std::make_shared<ResettableGoal>();
+	std::vector<std::shared_ptr<IPredicate>> predicates;
+
+	goal->SetNextPostcondition("B");
+	goal->Reset(predicates);
+
+	ASSERT_EQ(goal->GetActionsProducing("B").size(), 1);
+	ASSERT_TRUE(goal->GetActionsProducing("C").empty());
+
+	goal->SetNextPostcondition("C");
+	goal->Reset(predicates);
+
+	ASSERT_TRUE(goal->GetActionsProducing("B").empty());
+	ASSERT_EQ(goal->GetActionsProducing("C").size(), 1);
+	ASSERT_TRUE(goal->GetActionsProducing("C")[0] == goal->GetActions()[0]);
+}
+
+TEST(NAI_Goal, When_GoalIsCreatedByTheAgent_Then_ProducersOfItsActionsAreFound)
+{
+	const auto goal = std::make_shared<CreatedGoal>();
+	ASSERT_TRUE(goal->GetActionsProducing("FULL").empty());
+
+	AgentBuilder agentBuilder;
+	const auto agent = agentBuilder.WithGoapPlanner(std::make_shared<TreeGoapPlanner>())
+									.WithGoal(goal)
+									.Build<GoalOwnerAgentMock>();
+
+	const auto& producers = goal->GetActionsProducing("FULL");
+
+	ASSERT_EQ(producers.size(), 1);
+	ASSERT_TRUE(producers[0] == goal->GetActions()[0]);
+	ASSERT_TRUE(goal->GetActionsProducing("FOOD").empty());
+}
+
+TEST(NAI_Goal, When_GettingCostsOfSomeCandidates_Then_SameCostsThanOneByOne)
+{
+	const auto goal = std::make_shared<AmountCostGoal>();
+
+	std::vector<std::shared_ptr<IPredicate>> inputPredicates = { std::make_shared<BasePredicate>(1, "A") };
+	const std::vector<std::vector<std::shared_ptr<IPredicate>>> candidates = {
+		{},
+		{ std::make_shared<BasePredicate>(2, "B") },
+		{ std::make_shared<BasePredicate>(2, "B"), std::make_shared<BasePredicate>(3, "C") }
+	};
+
+	const auto costs = goal->GetCosts(inputPredicates, candidates);
+
+	ASSERT_EQ(costs.size(), candidates.size());
+	for (size_t i = 0; i < candidates.size(); ++i)
+	{
+		auto accomplishedPredicates = candidates[i];
+		ASSERT_EQ(costs[i], goal->GetCost(inputPredicates, accomplishedPredicates));
+	}
+}
+
+TEST(NAI_Goal, When_GettingCostsOfNoCandidates_Then_Empty)
+{
+	const auto goal = std::make_shared<AmountCostGoal>();
+
+	const auto costs = goal->GetCosts({}, {});
+
+	ASSERT_TRUE(costs.empty());
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include "goap/IAction.h"
+#include "goap/BaseAction.h"
+#include "goap/IPredicate.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+inline std::shared_ptr<NAI::Goap::IAction> CreateActionWith(std::vector<std::string> preconditions, std::vector<std::shared_ptr<NAI::Goap::IPredicate>> postconditions, unsigned int cost)
+{
+	return std::make_shared<NAI::Goap::BaseAction>(preconditions, postconditions, cost);
+}
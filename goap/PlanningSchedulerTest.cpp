@@ -0,0 +1,320 @@
+#include "gtest/gtest.h"
+#include "goap/agent/PlanningScheduler.h"
+#include "goap/agent/AgentBuilder.h"
+#include "goap/agent/BaseAgent.h"
+#include "goap/IGoapPlanner.h"
+#include "goap/planners/TreeGoapPlanner.h"
+#include "goap/BaseGoal.h"
+#include "goap/BaseAction.h"
+#include "goap/BasePredicate.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace NAI::Goap;
+
+class ScheduledAgentMock : public BaseAgent
+{
+public:
+	ScheduledAgentMock(const std::shared_ptr<IGoapPlanner> goapPlanner,
+		const std::vector<std::shared_ptr<IGoal>>& goals,
+		const std::vector<std::shared_ptr<IPredicate>>& predicates) :
+	ScheduledAgentMock(goapPlanner, goals, predicates, nullptr)
+	{
+	}
+
+	ScheduledAgentMock(const std::shared_ptr<IGoapPlanner> goapPlanner,
+		const std::vector<std::shared_ptr<IGoal>>& goals,
+		const std::vector<std::shared_ptr<IPredicate>>& predicates,
+		const std::shared_ptr<PerceptionSystem> perceptionSystem) :
+	BaseAgent(goapPlanner, goals, predicates, perceptionSystem)
+	{
+	}
+
+	virtual ~ScheduledAgentMock() = default;
+
+	glm::vec3 GetPosition() const override { return glm::vec3(0.0f); }
+	void MoveTo(float elapsedTime, const glm::vec3& point) override {}
+};
+
+//Every plan takes one millisecond of the fake clock. The first numFailedPlans plans find nothing.
+class OneMillisecondGoapPlanner : public IGoapPlanner
+{
+public:
+	OneMillisecondGoapPlanner(const std::shared_ptr<float>& clockMs, unsigned int numFailedPlans = 0) :
+	mClockMs{ clockMs },
+	mNumFailedPlans{ numFailedPlans },
+	mNumPlans{ 0 }
+	{
+	}
+	virtual ~OneMillisecondGoapPlanner() = default;
+
+	std::shared_ptr<IGoal> GetPlan(std::vector<std::shared_ptr<IGoal>>& goals, std::vector<std::shared_ptr<IPredicate>>& predicates) const override
+	{
+		*mClockMs += 1.0f;
+		++mNumPlans;
+		if (mNumPlans <= mNumFailedPlans)
+		{
+			return nullptr;
+		}
+
+		std::vector<std::string> preconditions = { "A" };
+		std::vector<std::shared_ptr<IPredicate>> postconditions = { std::make_shared<BasePredicate>(2, "B") };
+		std::vector<std::shared_ptr<IAction>> actions = { std::make_shared<BaseAction>(preconditions, postconditions) };
+
+		return std::make_shared<BaseGoal>(actions);
+	}
+
+	std::vector<std::shared_ptr<IGoal>> GetPlanToReach(
+		std::vector<std::shared_ptr<IGoal>>& goals,
+		std::vector<std::shared_ptr<IPredicate>>& predicates,
+		std::vector<std::shared_ptr<IPredicate>>& desiredPredicates) const override
+	{
+		return {};
+	}
+
+	unsigned int GetNumPlans() const { return mNumPlans; }
+
+private:
+	std::shared_ptr<float> mClockMs;
+	unsigned int mNumFailedPlans;
+	mutable unsigned int mNumPlans;
+};
+
+static std::shared_ptr<BaseAgent> CreateScheduledAgent(
+	const std::shared_ptr<IGoapPlanner>& planner,
+	const std::shared_ptr<PlanningScheduler>& scheduler,
+	unsigned int priority)
+{
+	AgentBuilder agentBuilder;
+	return agentBuilder.WithGoapPlanner(planner)
+						.WithPredicate(std::make_shared<BasePredicate>(1, "A"))
+						.WithPlanningScheduler(scheduler, priority)
+						.Build<ScheduledAgentMock>();
+}
+
+static std::shared_ptr<PlanningScheduler> CreateSchedulerWithFakeClock(float frameBudgetMs, const std::shared_ptr<float>& clockMs)
+{
+	return std::make_shared<PlanningScheduler>(frameBudgetMs, [clockMs]() { return *clockMs; });
+}
+
+TEST(NAI_PlanningScheduler, When_AgentsArePlanning_Then_TheyAreQueuedAndWaitForTheScheduler)
+{
+	const auto clockMs = std::make_shared<float>(0.0f);
+	const auto planner = std::make_shared<OneMillisecondGoapPlanner>(clockMs);
+	const auto scheduler = CreateSchedulerWithFakeClock(2.5f, clockMs);
+
+	std::vector<std::shared_ptr<BaseAgent>> agents;
+	for (auto i = 0; i < 5; ++i)
+	{
+		agents.push_back(CreateScheduledAgent(planner, scheduler, 0));
+		agents.back()->Update(0.016f);
+	}
+
+	ASSERT_EQ(planner->GetNumPlans(), 0);
+	ASSERT_EQ(scheduler->GetQueueDepth(), 5);
+
+	//waiting agents don't queue again
+	agents[0]->Update(0.016f);
+	ASSERT_EQ(scheduler->GetQueueDepth(), 5);
+	ASSERT_TRUE(agents[0]->GetCurrentState() == AgentState::STATE_PLANNING);
+}
+
+TEST(NAI_PlanningScheduler, When_Update_Then_AgentsAreServedWithinTheFrameBudget)
+{
+	const auto clockMs = std::make_shared<float>(0.0f);
+	const auto planner = std::make_shared<OneMillisecondGoapPlanner>(clockMs);
+	const auto scheduler = CreateSchedulerWithFakeClock(2.5f, clockMs);
+
+	std::vector<std::shared_ptr<BaseAgent>> agents;
+	for (auto i = 0; i < 5; ++i)
+	{
+		agents.push_back(CreateScheduledAgent(planner, scheduler, 0));
+		agents.back()->Update(0.016f);
+	}
+
+	scheduler->Update(0.016f);
+
+	ASSERT_EQ(planner->GetNumPlans(), 3);
+	ASSERT_EQ(scheduler->GetQueueDepth(), 2);
+	ASSERT_EQ(scheduler->GetNumServed(), 3);
+	for (auto i = 0; i < 5; ++i)
+	{
+		const auto expectedState = i < 3 ? AgentState::STATE_PROCESSING : AgentState::STATE_PLANNING;
+		ASSERT_TRUE(agents[i]->GetCurrentState() == expectedState);
+	}
+
+	scheduler->Update(0.016f);
+
+	ASSERT_EQ(scheduler->GetQueueDepth(), 0);
+	ASSERT_EQ(scheduler->GetNumServed(), 5);
+}
+
+TEST(NAI_PlanningScheduler, When_BudgetIsSmallerThanOnePlan_Then_OneAgentIsServedAnyway)
+{
+	const auto clockMs = std::make_shared<float>(0.0f);
+	const auto planner = std::make_shared<OneMillisecondGoapPlanner>(clockMs);
+	const auto scheduler = CreateSchedulerWithFakeClock(0.1f, clockMs);
+
+	std::vector<std::shared_ptr<BaseAgent>> agents;
+	for (auto i = 0; i < 3; ++i)
+	{
+		agents.push_back(CreateScheduledAgent(planner, scheduler, 0));
+		agents.back()->Update(0.016f);
+	}
+
+	scheduler->Update(0.016f);
+
+	ASSERT_EQ(planner->GetNumPlans(), 1);
+	ASSERT_EQ(scheduler->GetQueueDepth(), 2);
+}
+
+TEST(NAI_PlanningScheduler, When_AgentsHaveDifferentPriority_Then_HigherPriorityIsServedFirst)
+{
+	const auto clockMs = std::make_shared<float>(0.0f);
+	const auto planner = std::make_shared<OneMillisecondGoapPlanner>(clockMs);
+	const auto scheduler = CreateSchedulerWithFakeClock(0.5f, clockMs);
+
+	const auto lowPriorityAgent = CreateScheduledAgent(planner, scheduler, 1);
+	const auto highPriorityAgent = CreateScheduledAgent(planner, scheduler, 10);
+	lowPriorityAgent->Update(0.016f);
+	highPriorityAgent->Update(0.016f);
+
+	scheduler->Update(0.016f);
+
+	ASSERT_TRUE(highPriorityAgent->GetCurrentState() == AgentState::STATE_PROCESSING);
+	ASSERT_TRUE(lowPriorityAgent->GetCurrentState() == AgentState::STATE_PLANNING);
+}
+
+TEST(NAI_PlanningScheduler, When_AgentsHaveTheSamePriority_Then_LongestWaitingIsServedFirst)
+{
+	const auto clockMs = std::make_shared<float>(0.0f);
+	//the first plan finds nothing
+	const auto planner = std::make_shared<OneMillisecondGoapPlanner>(clockMs, 1);
+	const auto scheduler = CreateSchedulerWithFakeClock(0.5f, clockMs);
+
+	const auto firstAgent = CreateScheduledAgent(planner, scheduler, 5);
+	const auto secondAgent = CreateScheduledAgent(planner, scheduler, 5);
+	const auto thirdAgent = CreateScheduledAgent(planner, scheduler, 5);
+	firstAgent->Update(0.016f); //waiting since 0 ms
+	*clockMs += 5.0f;
+	secondAgent->Update(0.016f); //waiting since 5 ms
+	*clockMs += 5.0f;
+	thirdAgent->Update(0.016f); //waiting since 10 ms
+
+	*clockMs += 5.0f;
+	scheduler->Update(0.016f);
+	ASSERT_EQ(planner->GetNumPlans(), 1);
+	ASSERT_TRUE(firstAgent->GetCurrentState() == AgentState::STATE_PLANNING);
+
+	//the first agent got no plan and queues again, its wait starts over
+	*clockMs += 5.0f;
+	firstAgent->Update(0.016f); //waiting since 21 ms
+	ASSERT_EQ(scheduler->GetQueueDepth(), 3);
+
+	*clockMs += 5.0f;
+	scheduler->Update(0.016f);
+	ASSERT_TRUE(secondAgent->GetCurrentState() == AgentState::STATE_PROCESSING);
+	ASSERT_TRUE(firstAgent->GetCurrentState() == AgentState::STATE_PLANNING);
+	ASSERT_TRUE(thirdAgent->GetCurrentState() == AgentState::STATE_PLANNING);
+
+	*clockMs += 5.0f;
+	scheduler->Update(0.016f);
+	ASSERT_TRUE(thirdAgent->GetCurrentState() == AgentState::STATE_PROCESSING);
+	ASSERT_TRUE(firstAgent->GetCurrentState() == AgentState::STATE_PLANNING);
+
+	*clockMs += 5.0f;
+	scheduler->Update(0.016f);
+	ASSERT_TRUE(firstAgent->GetCurrentState() == AgentState::STATE_PROCESSING);
+}
+
+TEST(NAI_PlanningScheduler, When_AProcessingAgentHasToReplan_Then_ItKeepsProcessingItsPlanWhileItWaits)
+{
+	const auto clockMs = std::make_shared<float>(0.0f);
+	const auto scheduler = CreateSchedulerWithFakeClock(10.0f, clockMs);
+
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	std::vector<std::shared_ptr<IAction>> actions = {
+		std::make_shared<BaseAction>(std::vector<std::string>{ predicateA->GetText() }, std::vector<std::shared_ptr<IPredicate>>{ predicateB }),
+		std::make_shared<BaseAction>(std::vector<std::string>{ predicateB->GetText() }, std::vector<std::shared_ptr<IPredicate>>{ predicateC }) };
+
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(std::make_shared<TreeGoapPlanner>())
+								.WithGoal(std::make_shared<BaseGoal>(actions))
+								.WithPredicate(predicateA)
+								.WithPlanningScheduler(scheduler, 0)
+								.Build<ScheduledAgentMock>();
+
+	agent->Update(0.016f); //-->queues
+	scheduler->Update(0.016f); //-->gets the plan
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PROCESSING);
+
+	agent->OnNewPredicate(std::make_shared<BasePredicate>(4, "D"));
+
+	agent->Update(0.016f); //-->queues again and processes the first action meanwhile
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PROCESSING);
+	ASSERT_TRUE(agent->HasPredicate(predicateB->GetID()));
+	ASSERT_EQ(scheduler->GetQueueDepth(), 1);
+
+	scheduler->Update(0.016f); //-->gets the new plan
+	ASSERT_EQ(scheduler->GetQueueDepth(), 0);
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PROCESSING);
+}
+
+TEST(NAI_PlanningScheduler, When_AgentsWait_Then_LatencyAndQueueDepthMetricsAreUpdated)
+{
+	const auto clockMs = std::make_shared<float>(0.0f);
+	const auto planner = std::make_shared<OneMillisecondGoapPlanner>(clockMs);
+	const auto scheduler = CreateSchedulerWithFakeClock(0.5f, clockMs);
+
+	std::vector<std::shared_ptr<BaseAgent>> agents;
+	for (auto i = 0; i < 3; ++i)
+	{
+		agents.push_back(CreateScheduledAgent(planner, scheduler, 0));
+		agents.back()->Update(0.0f);
+	}
+
+	//one agent per 16 milliseconds frame, every plan takes one more millisecond
+	scheduler->Update(0.016f);
+	*clockMs += 16.0f;
+	scheduler->Update(0.016f);
+	*clockMs += 16.0f;
+	scheduler->Update(0.016f);
+
+	//the agents waited 0, 17 and 34 milliseconds
+	ASSERT_EQ(scheduler->GetMaxQueueDepth(), 3);
+	ASSERT_EQ(scheduler->GetQueueDepth(), 0);
+	ASSERT_NEAR(scheduler->GetMaxLatencyMs(), 34.0f, 0.001f);
+	ASSERT_NEAR(scheduler->GetAverageLatencyMs(), 17.0f, 0.001f);
+}
+
+TEST(NAI_PlanningScheduler, When_AQueuedAgentIsDestroyed_Then_ItIsDroppedWithoutPlanning)
+{
+	const auto clockMs = std::make_shared<float>(0.0f);
+	const auto planner = std::make_shared<OneMillisecondGoapPlanner>(clockMs);
+	const auto scheduler = CreateSchedulerWithFakeClock(10.0f, clockMs);
+
+	std::vector<std::shared_ptr<BaseAgent>> agents;
+	for (auto i = 0; i < 3; ++i)
+	{
+		agents.push_back(CreateScheduledAgent(planner, scheduler, 0));
+		agents.back()->Update(0.016f);
+	}
+
+	//the scheduler doesn't keep the agents alive
+	const std::weak_ptr<BaseAgent> destroyedAgent = agents[1];
+	agents[1].reset();
+	ASSERT_TRUE(destroyedAgent.expired());
+
+	scheduler->Update(0.016f);
+
+	ASSERT_EQ(planner->GetNumPlans(), 2);
+	ASSERT_EQ(scheduler->GetQueueDepth(), 0);
+	ASSERT_EQ(scheduler->GetNumServed(), 2);
+	ASSERT_TRUE(agents[0]->GetCurrentState() == AgentState::STATE_PROCESSING);
+	ASSERT_TRUE(agents[2]->GetCurrentState() == AgentState::STATE_PROCESSING);
+}
@@ -0,0 +1,214 @@
+#include "gtest/gtest.h"
+#include "goap/PredicatePayloadStore.h"
+#include "goap/PredicatesHandler.h"
+#include "goap/BaseGoal.h"
+#include "goap/predicates/BasePayloadPredicate.h"
+#include "goap/predicates/GoToPredicate.h"
+
+#include <memory>
+#include <vector>
+
+using namespace NAI::Goap;
+
+//The cost is the distance to the nearest food, read from the store instead of the predicates
+class NearestFoodGoal : public BaseGoal
+{
+public:
+	NearestFoodGoal(const std::shared_ptr<PredicatePayloadStore>& store) : mStore{ store } {}
+	virtual ~NearestFoodGoal() = default;
+
+	unsigned int GetCost(std::vector<std::shared_ptr<IPredicate>>& inputPredicates, std::vector<std::shared_ptr<IPredicate>>& accomplishedPredicates) const override
+	{
+		const auto id = mStore->FindNearest(glm::vec3(0.0f));
+		if (id == PredicatePayloadStore::INVALID_ID)
+		{
+			return 0;
+		}
+		return static_cast<unsigned int>(glm::distance(glm::vec3(0.0f), mStore->GetPosition(id)));
+	}
+
+private:
+	std::shared_ptr<PredicatePayloadStore> mStore;
+};
+
+TEST(NAI_PredicatePayloadStore, When_Empty_Then_NoNearest)
+{
+	const PredicatePayloadStore store;
+
+	ASSERT_EQ(store.GetSize(), 0);
+	ASSERT_EQ(store.FindNearest(glm::vec3(0.0f)), PredicatePayloadStore::INVALID_ID);
+}
+
+TEST(NAI_PredicatePayloadStore, When_SettingThePayloadOfAPredicate_Then_ItIsStoredByItsId)
+{
+	PredicatePayloadStore store;
+
+	store.SetPosition(1, glm::vec3(1.0f, 2.0f, 3.0f));
+	store.SetAmount(1, 5);
+
+	ASSERT_TRUE(store.Has(1));
+	ASSERT_FALSE(store.Has(2));
+	ASSERT_EQ(store.GetPosition(1), glm::vec3(1.0f, 2.0f, 3.0f));
+	ASSERT_EQ(store.GetAmount(1), 5);
+}
+
+TEST(NAI_PredicatePayloadStore, When_SettingThePayloadAgain_Then_ItIsUpdatedInPlace)
+{
+	PredicatePayloadStore store;
+
+	store.SetPosition(1, glm::vec3(1.0f));
+	store.SetPosition(1, glm::vec3(2.0f));
+
+	ASSERT_EQ(store.GetSize(), 1);
+	ASSERT_EQ(store.GetPosition(1), glm::vec3(2.0f));
+}
+
+TEST(NAI_PredicatePayloadStore, When_SomePositions_Then_NearestIsFound)
+{
+	PredicatePayloadStore store;
+
+	store.SetPosition(1, glm::vec3(10.0f, 0.0f, 0.0f));
+	store.SetPosition(2, glm::vec3(2.0f, 0.0f, 0.0f));
+	store.SetPosition(3, glm::vec3(-5.0f, 0.0f, 0.0f));
+
+	ASSERT_EQ(store.FindNearest(glm::vec3(0.0f)), 2);
+	ASSERT_EQ(store.FindNearest(glm::vec3(-4.0f, 0.0f, 0.0f)), 3);
+}
+
+TEST(NAI_PredicatePayloadStore, When_Removed_Then_TheOthersAreStillFound)
+{
+	PredicatePayloadStore store;
+
+	store.SetPosition(1, glm::vec3(10.0f, 0.0f, 0.0f));
+	store.SetPosition(2, glm::vec3(2.0f, 0.0f, 0.0f));
+	store.SetPosition(3, glm::vec3(-5.0f, 0.0f, 0.0f));
+
+	store.Remove(2);
+
+	ASSERT_EQ(store.GetSize(), 2);
+	ASSERT_FALSE(store.Has(2));
+	ASSERT_EQ(store.GetPosition(1), glm::vec3(10.0f, 0.0f, 0.0f));
+	ASSERT_EQ(store.GetPosition(3), glm::vec3(-5.0f, 0.0f, 0.0f));
+	ASSERT_EQ(store.FindNearest(glm::vec3(0.0f)), 3);
+}
+
+TEST(NAI_PredicatePayloadStore, When_FindingNearestAmongCandidates_Then_OthersAreIgnored)
+{
+	PredicatePayloadStore store;
+
+	store.SetPosition(1, glm::vec3(10.0f, 0.0f, 0.0f));
+	store.SetPosition(2, glm::vec3(2.0f, 0.0f, 0.0f));
+	store.SetPosition(3, glm::vec3(-5.0f, 0.0f, 0.0f));
+
+	ASSERT_EQ(store.FindNearest(glm::vec3(0.0f), { 1, 3 }), 3);
+	ASSERT_EQ(store.FindNearest(glm::vec3(0.0f), { 4 }), PredicatePayloadStore::INVALID_ID);
+}
+
+TEST(NAI_PredicatePayloadStore, When_FindingNearestWithAmount_Then_NotEnoughAmountIsIgnored)
+{
+	PredicatePayloadStore store;
+
+	store.SetPosition(1, glm::vec3(1.0f, 0.0f, 0.0f));
+	store.SetAmount(1, 0);
+	store.SetPosition(2, glm::vec3(5.0f, 0.0f, 0.0f));
+	store.SetAmount(2, 3);
+
+	ASSERT_EQ(store.FindNearestWithAmount(glm::vec3(0.0f), 1), 2);
+	ASSERT_EQ(store.FindNearestWithAmount(glm::vec3(0.0f), 4), PredicatePayloadStore::INVALID_ID);
+}
+
+TEST(NAI_PredicatePayloadStore, When_GettingDistancesOfManyPredicates_Then_SameThanOneByOne)
+{
+	PredicatePayloadStore store;
+	std::vector<int> ids;
+
+	for (auto id = 0; id < 1000; ++id)
+	{
+		store.SetPosition(id, glm::vec3(static_cast<float>(id % 37), static_cast<float>(id % 11), static_cast<float>(id)));
+		ids.push_back(id);
+	}
+
+	const glm::vec3 point(3.0f, 4.0f, 5.0f);
+	const auto distances = store.GetDistances(point, ids);
+
+	ASSERT_EQ(distances.size(), ids.size());
+	for (size_t i = 0; i < ids.size(); ++i)
+	{
+		ASSERT_FLOAT_EQ(distances[i], glm::distance(point, store.GetPosition(ids[i])));
+	}
+}
+
+TEST(NAI_PredicatePayloadStore, When_SubscribedToThePredicatesHandler_Then_PayloadPredicatesAreStored)
+{
+	const auto store = std::make_shared<PredicatePayloadStore>();
+	PredicatesHandler predicatesHandler;
+	predicatesHandler.Subscribe(store);
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePayloadPredicate>(1, "FOOD", glm::vec3(10.0f, 0.0f, 0.0f), 3));
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(2, "HUNGRY"));
+
+	ASSERT_EQ(store->GetSize(), 1);
+	ASSERT_EQ(store->GetPosition(1), glm::vec3(10.0f, 0.0f, 0.0f));
+	ASSERT_EQ(store->GetAmount(1), 3);
+	ASSERT_FALSE(store->Has(2));
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePayloadPredicate>(1, "FOOD", glm::vec3(4.0f, 0.0f, 0.0f), 2));
+
+	ASSERT_EQ(store->GetSize(), 1);
+	ASSERT_EQ(store->GetPosition(1), glm::vec3(4.0f, 0.0f, 0.0f));
+	ASSERT_EQ(store->GetAmount(1), 2);
+}
+
+TEST(NAI_PredicatePayloadStore, When_SubscribedAndAGoToPredicateIsAdded_Then_ItsPositionIsStored)
+{
+	const auto store = std::make_shared<PredicatePayloadStore>();
+	PredicatesHandler predicatesHandler;
+	predicatesHandler.Subscribe(store);
+
+	const glm::vec3 destination(5.0f, 0.0f, 10.0f);
+	predicatesHandler.AddOrReplace(std::make_shared<GoToPredicate>(1, PREDICATE_GO_TO_NAME, destination));
+
+	ASSERT_TRUE(store->Has(1));
+	ASSERT_EQ(store->GetPosition(1), destination);
+	ASSERT_EQ(store->FindNearest(glm::vec3(0.0f)), 1);
+
+	predicatesHandler.Remove(1);
+
+	ASSERT_FALSE(store->Has(1));
+}
+
+TEST(NAI_PredicatePayloadStore, When_PredicateIsRemovedFromTheHandler_Then_ItIsRemovedFromTheStore)
+{
+	const auto store = std::make_shared<PredicatePayloadStore>();
+	PredicatesHandler predicatesHandler;
+	predicatesHandler.Subscribe(store);
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePayloadPredicate>(1, "FOOD", glm::vec3(10.0f, 0.0f, 0.0f), 1));
+	predicatesHandler.AddOrReplace(std::make_shared<BasePayloadPredicate>(2, "FOOD", glm::vec3(2.0f, 0.0f, 0.0f), 1));
+
+	predicatesHandler.Remove(2);
+
+	ASSERT_FALSE(store->Has(2));
+	ASSERT_EQ(store->GetSize(), predicatesHandler.GetPredicatesList().size());
+	ASSERT_EQ(store->FindNearest(glm::vec3(0.0f)), 1);
+}
+
+TEST(NAI_PredicatePayloadStore, When_GoalCostReadsTheStore_Then_ItFollowsThePredicates)
+{
+	const auto store = std::make_shared<PredicatePayloadStore>();
+	PredicatesHandler predicatesHandler;
+	predicatesHandler.Subscribe(store);
+
+	const auto goal = std::make_shared<NearestFoodGoal>(store);
+	std::vector<std::shared_ptr<IPredicate>> inputPredicates;
+	std::vector<std::shared_ptr<IPredicate>> accomplishedPredicates;
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePayloadPredicate>(1, "FOOD", glm::vec3(10.0f, 0.0f, 0.0f), 1));
+	predicatesHandler.AddOrReplace(std::make_shared<BasePayloadPredicate>(2, "FOOD", glm::vec3(2.0f, 0.0f, 0.0f), 1));
+
+	ASSERT_EQ(goal->GetCost(inputPredicates, accomplishedPredicates), 2);
+
+	predicatesHandler.Remove(2);
+
+	ASSERT_EQ(goal->GetCost(inputPredicates, accomplishedPredicates), 10);
+}
@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+#include "goap/PredicateSymbolTable.h"
+#include "goap/IPredicate.h"
+#include "goap/BasePredicate.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NAI::Goap;
+
+//The symbol table is global and other tests intern texts too, so every test
+//checks values relative to what the table holds when the test starts.
+
+static std::string CreateNotInternedText(const std::string& prefix)
+{
+	auto text = prefix + std::to_string(PredicateSymbolTable::GetSize());
+	while (PredicateSymbolTable::Contains(text))
+	{
+		text += "_";
+	}
+	return text;
+}
+
+TEST(NAI_PredicateSymbolTable, When_InterningTheSameTextTwice_Then_SameAtom)
+{
+	const auto text = CreateNotInternedText("SymbolTable_SameText");
+	const auto size = PredicateSymbolTable::GetSize();
+
+	const auto atom1 = PredicateSymbolTable::Intern(text);
+	const auto atom2 = PredicateSymbolTable::Intern(text);
+
+	ASSERT_EQ(atom1, atom2);
+	ASSERT_EQ(PredicateSymbolTable::GetSize(), size + 1);
+}
+
+TEST(NAI_PredicateSymbolTable, When_InterningDifferentTexts_Then_ConsecutiveAtoms)
+{
+	const auto firstText = CreateNotInternedText("SymbolTable_First");
+	const auto secondText = CreateNotInternedText("SymbolTable_Second");
+	const auto size = PredicateSymbolTable::GetSize();
+
+	const auto atom1 = PredicateSymbolTable::Intern(firstText);
+	const auto atom2 = PredicateSymbolTable::Intern(secondText);
+
+	ASSERT_EQ(atom1, size);
+	ASSERT_EQ(atom2, atom1 + 1);
+	ASSERT_EQ(PredicateSymbolTable::GetSize(), size + 2);
+}
+
+TEST(NAI_PredicateSymbolTable, When_AskingTheTextOfAnAtom_Then_OriginalText)
+{
+	const auto text = CreateNotInternedText("SymbolTable_Text");
+	const auto atom = PredicateSymbolTable::Intern(text);
+
+	ASSERT_EQ(PredicateSymbolTable::GetText(atom), text);
+}
+
+TEST(NAI_PredicateSymbolTable, When_PredicateIsCreated_Then_ItsTextIsInterned)
+{
+	const auto text = CreateNotInternedText("SymbolTable_Predicate");
+	ASSERT_FALSE(PredicateSymbolTable::Contains(text));
+
+	const auto predicate = std::make_shared<BasePredicate>(1, text);
+
+	ASSERT_TRUE(PredicateSymbolTable::Contains(text));
+	ASSERT_EQ(predicate->GetAtom(), PredicateSymbolTable::Intern(text));
+}
+
+TEST(NAI_PredicateSymbolTable, When_TwoPredicatesShareText_Then_SameAtom)
+{
+	const auto predicateA = std::make_shared<BasePredicate>(1, "SymbolTable_Shared");
+	const auto predicateB = std::make_shared<BasePredicate>(2, "SymbolTable_Shared");
+	const auto predicateC = std::make_shared<BasePredicate>(3, "SymbolTable_NotShared");
+
+	ASSERT_EQ(predicateA->GetAtom(), predicateB->GetAtom());
+	ASSERT_NE(predicateA->GetAtom(), predicateC->GetAtom());
+}
+
+TEST(NAI_PredicateSymbolTable, When_SomeThreadsInternTheSameTexts_Then_AllOfThemGetTheSameAtoms)
+{
+	const auto numTexts = 200;
+	const auto numThreads = 4;
+
+	std::vector<std::string> texts;
+	for (auto i = 0; i < numTexts; ++i)
+	{
+		texts.push_back(CreateNotInternedText("SymbolTable_Concurrent" + std::to_string(i) + "_"));
+	}
+	const auto size = PredicateSymbolTable::GetSize();
+
+	std::vector<std::vector<PredicateAtom>> atomsPerThread(numThreads, std::vector<PredicateAtom>(numTexts));
+	std::vector<std::thread> threads;
+	for (auto t = 0; t < numThreads; ++t)
+	{
+		threads.emplace_back([&texts, &atomsPerThread, t]()
+		{
+			//half of the threads go backwards so they race for different texts first
+			for (auto i = 0; i < numTexts; ++i)
+			{
+				const auto index = t % 2 == 0 ? i : numTexts - 1 - i;
+				atomsPerThread[t][index] = PredicateSymbolTable::Intern(texts[index]);
+			}
+		});
+	}
+	for (auto&& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (auto t = 1; t < numThreads; ++t)
+	{
+		ASSERT_EQ(atomsPerThread[t], atomsPerThread[0]);
+	}
+	for (auto i = 0; i < numTexts; ++i)
+	{
+		ASSERT_EQ(PredicateSymbolTable::GetText(atomsPerThread[0][i]), texts[i]);
+	}
+	ASSERT_EQ(PredicateSymbolTable::GetSize(), size + numTexts);
+}
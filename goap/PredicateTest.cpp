@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+#include "goap/IPredicate.h"
+#include "goap/BasePredicate.h"
+
+#include <memory>
+#include <string>
+
+using namespace NAI::Goap;
+
+class QuantityPredicate : public BasePredicate
+{
+public:
+	QuantityPredicate(int id, const std::string& text, unsigned int quantity) : BasePredicate(id, text), mQuantity{ quantity } {}
+	virtual ~QuantityPredicate() = default;
+
+	bool HasSameContent(const std::shared_ptr<IPredicate>& other) const override
+	{
+		//BasePredicate already checks both are of the same type
+		return BasePredicate::HasSameContent(other) &&
+			std::static_pointer_cast<QuantityPredicate>(other)->mQuantity == mQuantity;
+	}
+
+private:
+	unsigned int mQuantity;
+};
+
+TEST(NAI_Predicate, When_SameTextInAnotherInstance_Then_SameContent)
+{
+	const auto predicate = std::make_shared<BasePredicate>(1, "A");
+
+	ASSERT_TRUE(predicate->HasSameContent(predicate));
+	ASSERT_TRUE(predicate->HasSameContent(std::make_shared<BasePredicate>(1, "A")));
+}
+
+TEST(NAI_Predicate, When_DifferentText_Then_DifferentContent)
+{
+	const auto predicate = std::make_shared<BasePredicate>(1, "A");
+
+	ASSERT_FALSE(predicate->HasSameContent(std::make_shared<BasePredicate>(1, "B")));
+}
+
+TEST(NAI_Predicate, When_DifferentType_Then_DifferentContent)
+{
+	const auto predicate = std::make_shared<BasePredicate>(1, "A");
+	const auto quantityPredicate = std::make_shared<QuantityPredicate>(1, "A", 3);
+
+	ASSERT_FALSE(predicate->HasSameContent(quantityPredicate));
+	ASSERT_FALSE(quantityPredicate->HasSameContent(predicate));
+}
+
+TEST(NAI_Predicate, When_SameTextButDifferentPayload_Then_DifferentContent)
+{
+	const auto predicate = std::make_shared<QuantityPredicate>(1, "A", 3);
+
+	ASSERT_TRUE(predicate->HasSameContent(std::make_shared<QuantityPredicate>(1, "A", 3)));
+	ASSERT_FALSE(predicate->HasSameContent(std::make_shared<QuantityPredicate>(1, "A", 4)));
+}
@@ -1,6 +1,9 @@
 #include "gtest/gtest.h"
 #include "goap/PredicatesHandler.h"
 #include "goap/BasePredicate.h"
+#ifdef NAI_NEXT_API
+#include "goap/PredicateChange.h"
+#endif
 
 #include <memory>
 #include <vector>
@@ -186,4 +189,349 @@ TEST(NAI_PredicatesHandler, When_Remove_Then_PredicateIsRemoved)
 	
 	ASSERT_EQ(sizeAfterRemove, predicatesTexts.size() - 1);
 	ASSERT_FALSE(predicatesHandler.FindByText(predicatesTexts[1]) != nullptr);
-}
\ No newline at end of file
+}
+
+#ifdef NAI_NEXT_API
+TEST(NAI_PredicatesHandler, When_PredicatesChange_Then_VersionIncreases)
+{
+	PredicatesHandler predicatesHandler;
+
+	auto version = predicatesHandler.GetVersion();
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(1, "I feel good"));
+	ASSERT_GT(predicatesHandler.GetVersion(), version);
+	version = predicatesHandler.GetVersion();
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(1, "I feel good"));
+	ASSERT_GT(predicatesHandler.GetVersion(), version);
+	version = predicatesHandler.GetVersion();
+
+	predicatesHandler.Remove(1);
+	ASSERT_GT(predicatesHandler.GetVersion(), version);
+	version = predicatesHandler.GetVersion();
+
+	std::vector<std::shared_ptr<IPredicate>> newPredicates{ std::make_shared<BasePredicate>(2, "I have an axe") };
+	predicatesHandler.Reset(newPredicates);
+	ASSERT_GT(predicatesHandler.GetVersion(), version);
+}
+
+TEST(NAI_PredicatesHandler, When_Finding_Then_VersionDoesNotChange)
+{
+	PredicatesHandler predicatesHandler;
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(1, "I feel good"));
+	const auto version = predicatesHandler.GetVersion();
+
+	predicatesHandler.FindById(1);
+	predicatesHandler.FindByText("I feel good");
+
+	ASSERT_EQ(predicatesHandler.GetVersion(), version);
+}
+#endif
+
+TEST(NAI_PredicatesHandler, When_ManyPredicatesAreAddedAndRemoved_Then_AllOfThemAreFoundByIdAndText)
+{
+	PredicatesHandler predicatesHandler;
+	const auto numPredicates = 1000;
+
+	for (auto id = 0; id < numPredicates; ++id)
+	{
+		predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(id, "predicate " + std::to_string(id)));
+	}
+
+	//removes the even ones
+	for (auto id = 0; id < numPredicates; id += 2)
+	{
+		predicatesHandler.Remove(id);
+	}
+
+	ASSERT_EQ(predicatesHandler.GetPredicatesList().size(), numPredicates / 2);
+
+	for (auto id = 0; id < numPredicates; ++id)
+	{
+		const auto text = "predicate " + std::to_string(id);
+		const auto isRemoved = id % 2 == 0;
+
+		ASSERT_EQ(predicatesHandler.FindById(id) == nullptr, isRemoved);
+		ASSERT_EQ(predicatesHandler.FindByText(text) == nullptr, isRemoved);
+	}
+
+	const auto& predicatesList = predicatesHandler.GetPredicatesList();
+	for (size_t i = 0; i < predicatesList.size(); ++i)
+	{
+		ASSERT_EQ(predicatesList[i]->GetID(), static_cast<int>(i * 2 + 1));
+	}
+}
+
+TEST(NAI_PredicatesHandler, When_Reset_Then_OldPredicatesAreNotFound)
+{
+	PredicatesHandler predicatesHandler;
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(1, "I feel good"));
+
+	std::vector<std::shared_ptr<IPredicate>> newPredicates{ std::make_shared<BasePredicate>(2, "I have an axe") };
+	predicatesHandler.Reset(newPredicates);
+
+	ASSERT_FALSE(predicatesHandler.FindById(1));
+	ASSERT_FALSE(predicatesHandler.FindByText("I feel good"));
+	ASSERT_EQ(predicatesHandler.FindById(2)->GetText(), "I have an axe");
+}
+
+#ifdef NAI_NEXT_API
+TEST(NAI_PredicatesHandler, When_ReplacingAPredicate_Then_ItKeepsItsPositionAndTheNewTextIsFound)
+{
+	PredicatesHandler predicatesHandler;
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(1, "I feel good"));
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(2, "I have an axe"));
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(3, "I am in my house"));
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(2, "I have a sword"));
+
+	const auto& predicatesList = predicatesHandler.GetPredicatesList();
+
+	ASSERT_EQ(predicatesList.size(), 3);
+	ASSERT_EQ(predicatesList[0]->GetID(), 1);
+	ASSERT_EQ(predicatesList[1]->GetID(), 2);
+	ASSERT_EQ(predicatesList[2]->GetID(), 3);
+	ASSERT_EQ(predicatesList[1]->GetText(), "I have a sword");
+	ASSERT_FALSE(predicatesHandler.FindByText("I have an axe"));
+	ASSERT_EQ(predicatesHandler.FindByText("I have a sword")->GetID(), 2);
+}
+
+TEST(NAI_PredicatesHandler, When_RemovingAndAddingAgain_Then_InsertionOrderIsKept)
+{
+	PredicatesHandler predicatesHandler;
+
+	for (auto id = 1; id <= 4; ++id)
+	{
+		predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(id, "predicate " + std::to_string(id)));
+	}
+
+	predicatesHandler.Remove(2);
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(2, "predicate 2"));
+
+	const auto& predicatesList = predicatesHandler.GetPredicatesList();
+	const std::vector<int> expectedIds = { 1, 3, 4, 2 };
+
+	ASSERT_EQ(predicatesList.size(), expectedIds.size());
+	for (size_t i = 0; i < expectedIds.size(); ++i)
+	{
+		ASSERT_EQ(predicatesList[i]->GetID(), expectedIds[i]);
+		ASSERT_EQ(predicatesHandler.FindById(expectedIds[i])->GetID(), expectedIds[i]);
+	}
+}
+
+TEST(NAI_PredicatesHandler, When_SomePredicatesShareText_Then_AllOfThemAreFoundInInsertionOrder)
+{
+	PredicatesHandler predicatesHandler;
+
+	for (auto id = 1; id <= 3; ++id)
+	{
+		predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(id, "FOOD"));
+	}
+
+	const auto predicates = predicatesHandler.FindAllByText("FOOD");
+
+	ASSERT_EQ(predicates.size(), 3);
+	ASSERT_EQ(predicates[0]->GetID(), 1);
+	ASSERT_EQ(predicates[1]->GetID(), 2);
+	ASSERT_EQ(predicates[2]->GetID(), 3);
+	ASSERT_EQ(predicatesHandler.FindByText("FOOD")->GetID(), 1);
+}
+
+TEST(NAI_PredicatesHandler, When_RemovingOneOfThePredicatesSharingText_Then_TheOthersAreStillFound)
+{
+	PredicatesHandler predicatesHandler;
+
+	for (auto id = 1; id <= 3; ++id)
+	{
+		predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(id, "FOOD"));
+	}
+
+	predicatesHandler.Remove(2);
+
+	auto predicates = predicatesHandler.FindAllByText("FOOD");
+
+	ASSERT_EQ(predicates.size(), 2);
+	ASSERT_EQ(predicates[0]->GetID(), 1);
+	ASSERT_EQ(predicates[1]->GetID(), 3);
+
+	predicatesHandler.Remove(1);
+	predicates = predicatesHandler.FindAllByText("FOOD");
+
+	ASSERT_EQ(predicates.size(), 1);
+	ASSERT_EQ(predicatesHandler.FindByText("FOOD")->GetID(), 3);
+}
+
+TEST(NAI_PredicatesHandler, When_TakingASnapshot_Then_ItHasThePredicatesAndTheVersion)
+{
+	PredicatesHandler predicatesHandler;
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(1, "I feel good"));
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(2, "I have an axe"));
+
+	const auto snapshot = predicatesHandler.GetSnapshot();
+
+	ASSERT_EQ(snapshot.GetVersion(), predicatesHandler.GetVersion());
+	ASSERT_EQ(snapshot.GetPredicates().size(), 2);
+	ASSERT_EQ(snapshot.GetPredicates()[0]->GetID(), 1);
+	ASSERT_EQ(snapshot.GetPredicates()[1]->GetID(), 2);
+	ASSERT_EQ(snapshot.FindById(2)->GetText(), "I have an axe");
+}
+
+TEST(NAI_PredicatesHandler, When_PredicatesChangeAfterASnapshot_Then_SnapshotDoesNotChange)
+{
+	PredicatesHandler predicatesHandler;
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(1, "I feel good"));
+	const auto snapshot = predicatesHandler.GetSnapshot();
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(2, "I have an axe"));
+	predicatesHandler.Remove(1);
+
+	ASSERT_EQ(snapshot.GetPredicates().size(), 1);
+	ASSERT_EQ(snapshot.GetPredicates()[0]->GetID(), 1);
+	ASSERT_LT(snapshot.GetVersion(), predicatesHandler.GetVersion());
+	ASSERT_EQ(predicatesHandler.GetSnapshot().GetPredicates()[0]->GetID(), 2);
+}
+
+TEST(NAI_PredicatesHandler, When_TakingSnapshotsWithoutChanges_Then_TheyShareThePredicates)
+{
+	PredicatesHandler predicatesHandler;
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(1, "I feel good"));
+
+	const auto snapshot1 = predicatesHandler.GetSnapshot();
+	const auto snapshot2 = predicatesHandler.GetSnapshot();
+
+	ASSERT_EQ(snapshot1.GetVersion(), snapshot2.GetVersion());
+	ASSERT_EQ(&snapshot1.GetPredicates(), &snapshot2.GetPredicates());
+}
+
+class PredicateChangeSubscriber : public core::utils::subscriber::ISubscriber<PredicateChange>
+{
+public:
+	PredicateChangeSubscriber() = default;
+	virtual ~PredicateChangeSubscriber() = default;
+
+	void OnNotification(std::shared_ptr<PredicateChange> change) override { changes.push_back(*change); }
+
+	std::vector<PredicateChange> changes;
+};
+
+TEST(NAI_PredicatesHandler, When_PredicatesChange_Then_ChangesAreInTheJournal)
+{
+	PredicatesHandler predicatesHandler;
+	const auto version = predicatesHandler.GetVersion();
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(1, "I feel good"));
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(2, "I have an axe"));
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(1, "I feel bad"));
+	predicatesHandler.Remove(2);
+
+	const auto changes = predicatesHandler.GetChangesSince(version);
+
+	ASSERT_EQ(changes.size(), 4);
+	ASSERT_TRUE(changes[0].type == PredicateChange::Type::ADDED);
+	ASSERT_EQ(changes[0].id, 1);
+	ASSERT_TRUE(changes[1].type == PredicateChange::Type::ADDED);
+	ASSERT_EQ(changes[1].id, 2);
+	ASSERT_TRUE(changes[2].type == PredicateChange::Type::REPLACED);
+	ASSERT_EQ(changes[2].id, 1);
+	ASSERT_TRUE(changes[3].type == PredicateChange::Type::REMOVED);
+	ASSERT_EQ(changes[3].id, 2);
+	ASSERT_EQ(changes[3].version, predicatesHandler.GetVersion());
+	for (size_t i = 1; i < changes.size(); ++i)
+	{
+		ASSERT_GT(changes[i].version, changes[i - 1].version);
+	}
+}
+
+TEST(NAI_PredicatesHandler, When_AskingChangesSinceAVersion_Then_OnlyLaterChangesAreReturned)
+{
+	PredicatesHandler predicatesHandler;
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(1, "I feel good"));
+	const auto version = predicatesHandler.GetVersion();
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(2, "I have an axe"));
+
+	const auto changes = predicatesHandler.GetChangesSince(version);
+
+	ASSERT_EQ(changes.size(), 1);
+	ASSERT_EQ(changes[0].id, 2);
+	ASSERT_TRUE(predicatesHandler.GetChangesSince(predicatesHandler.GetVersion()).empty());
+}
+
+TEST(NAI_PredicatesHandler, When_RemovingAPredicateThatDoesntExist_Then_NoChange)
+{
+	PredicatesHandler predicatesHandler;
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(1, "I feel good"));
+	const auto version = predicatesHandler.GetVersion();
+
+	predicatesHandler.Remove(2);
+
+	ASSERT_EQ(predicatesHandler.GetVersion(), version);
+	ASSERT_TRUE(predicatesHandler.GetChangesSince(version).empty());
+}
+
+TEST(NAI_PredicatesHandler, When_Reset_Then_OldPredicatesAreRemovedAndNewOnesAddedInTheJournal)
+{
+	PredicatesHandler predicatesHandler;
+
+	predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(1, "I feel good"));
+	const auto version = predicatesHandler.GetVersion();
+
+	std::vector<std::shared_ptr<IPredicate>> newPredicates{ std::make_shared<BasePredicate>(2, "I have an axe") };
+	predicatesHandler.Reset(newPredicates);
+
+	const auto changes = predicatesHandler.GetChangesSince(version);
+
+	ASSERT_EQ(changes.size(), 2);
+	ASSERT_TRUE(changes[0].type == PredicateChange::Type::REMOVED);
+	ASSERT_EQ(changes[0].id, 1);
+	ASSERT_TRUE(changes[1].type == PredicateChange::Type::ADDED);
+	ASSERT_EQ(changes[1].id, 2);
+}
+
+TEST(NAI_PredicatesHandler, When_ChangesAreOlderThanTheJournalCapacity_Then_TheyCanNotBeAsked)
+{
+	PredicatesHandler predicatesHandler;
+	predicatesHandler.SetJournalCapacity(2);
+
+	const auto version = predicatesHandler.GetVersion();
+	for (auto id = 1; id <= 3; ++id)
+	{
+		predicatesHandler.AddOrReplace(std::make_shared<BasePredicate>(id, "predicate " + std::to_string(id)));
+	}
+
+	//the consumer has to read the whole list again
+	ASSERT_FALSE(predicatesHandler.CanGetChangesSince(version));
+	ASSERT_TRUE(predicatesHandler.CanGetChangesSince(predicatesHandler.GetVersion() - 2));
+	ASSERT_EQ(predicatesHandler.GetChangesSince(predicatesHandler.GetVersion() - 2).size(), 2);
+}
+
+TEST(NAI_PredicatesHandler, When_Subscribed_Then_ChangesAreNotified)
+{
+	PredicatesHandler predicatesHandler;
+	const auto subscriber = std::make_shared<PredicateChangeSubscriber>();
+	predicatesHandler.Subscribe(subscriber);
+
+	const auto predicate = std::make_shared<BasePredicate>(1, "I feel good");
+	const auto newPredicate = std::make_shared<BasePredicate>(1, "I feel bad");
+	predicatesHandler.AddOrReplace(predicate);
+	predicatesHandler.AddOrReplace(newPredicate);
+	predicatesHandler.Remove(1);
+
+	//added and replaced changes carry the predicate, so subscribers don't have to look it up
+	ASSERT_EQ(subscriber->changes.size(), 3);
+	ASSERT_TRUE(subscriber->changes[0].type == PredicateChange::Type::ADDED);
+	ASSERT_TRUE(subscriber->changes[0].predicate == predicate);
+	ASSERT_TRUE(subscriber->changes[1].type == PredicateChange::Type::REPLACED);
+	ASSERT_TRUE(subscriber->changes[1].predicate == newPredicate);
+	ASSERT_TRUE(subscriber->changes[2].type == PredicateChange::Type::REMOVED);
+	ASSERT_EQ(subscriber->changes[2].id, 1);
+	ASSERT_EQ(subscriber->changes[2].version, predicatesHandler.GetVersion());
+}
+#endif
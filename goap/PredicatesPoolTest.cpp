@@ -0,0 +1,136 @@
+#include "gtest/gtest.h"
+#include "goap/PredicatesPool.h"
+#include "goap/PredicatesHandler.h"
+#include "goap/BasePredicate.h"
+
+#include <memory>
+#include <string>
+
+using namespace NAI::Goap;
+
+class PooledAmountPredicate : public BasePredicate
+{
+public:
+	PooledAmountPredicate(int id, const std::string& text, unsigned int amount) : BasePredicate(id, text), mAmount{ amount } {}
+	virtual ~PooledAmountPredicate() = default;
+
+	unsigned int GetAmount() const { return mAmount; }
+
+	bool HasSameContent(const std::shared_ptr<IPredicate>& other) const override
+	{
+		//BasePredicate already checks both are of the same type
+		return BasePredicate::HasSameContent(other) &&
+			std::static_pointer_cast<PooledAmountPredicate>(other)->mAmount == mAmount;
+	}
+
+private:
+	unsigned int mAmount;
+};
+
+TEST(NAI_PredicatesPool, When_AcquiringAPredicate_Then_ItIsCreated)
+{
+	PredicatesPool pool;
+
+	const auto predicate = pool.Acquire<PooledAmountPredicate>(1, std::string("AMOUNT"), 5u);
+
+	ASSERT_TRUE(predicate != nullptr);
+	ASSERT_EQ(predicate->GetID(), 1);
+	ASSERT_EQ(predicate->GetText(), "AMOUNT");
+	ASSERT_EQ(predicate->GetAmount(), 5);
+	ASSERT_EQ(pool.GetSize(), 1);
+	ASSERT_EQ(pool.GetNumAllocations(), 1);
+}
+
+TEST(NAI_PredicatesPool, When_AcquiringAPredicateNobodyElseHolds_Then_ItIsRecycledAndUpdatedInPlace)
+{
+	PredicatesPool pool;
+
+	const auto predicate = pool.Acquire<PooledAmountPredicate>(1, std::string("AMOUNT"), 5u).get();
+	const auto recycledPredicate = pool.Acquire<PooledAmountPredicate>(1, std::string("AMOUNT"), 7u);
+
+	ASSERT_EQ(recycledPredicate.get(), predicate);
+	ASSERT_EQ(recycledPredicate->GetAmount(), 7);
+	ASSERT_EQ(pool.GetSize(), 1);
+	ASSERT_EQ(pool.GetNumAllocations(), 1);
+}
+
+TEST(NAI_PredicatesPool, When_AcquiringAPublishedPredicateWithTheSameContent_Then_SameInstanceWithoutAllocating)
+{
+	PredicatesPool pool;
+	PredicatesHandler predicatesHandler;
+
+	const auto predicate = pool.Acquire<PooledAmountPredicate>(1, std::string("AMOUNT"), 5u);
+	predicatesHandler.AddOrReplace(predicate);
+
+	const auto samePredicate = pool.Acquire<PooledAmountPredicate>(1, std::string("AMOUNT"), 5u);
+
+	ASSERT_TRUE(samePredicate == predicate);
+	ASSERT_TRUE(predicatesHandler.FindById(1) == predicate);
+	ASSERT_EQ(pool.GetNumAllocations(), 1);
+}
+
+TEST(NAI_PredicatesPool, When_AcquiringAPublishedPredicateWithOtherContent_Then_ItIsCopiedAndTheOldOneDoesNotChange)
+{
+	PredicatesPool pool;
+	PredicatesHandler predicatesHandler;
+
+	const auto publishedPredicate = pool.Acquire<PooledAmountPredicate>(1, std::string("AMOUNT"), 5u);
+	predicatesHandler.AddOrReplace(publishedPredicate);
+
+	const auto newPredicate = pool.Acquire<PooledAmountPredicate>(1, std::string("AMOUNT"), 7u);
+
+	ASSERT_TRUE(newPredicate != publishedPredicate);
+	ASSERT_EQ(publishedPredicate->GetAmount(), 5);
+	ASSERT_EQ(std::static_pointer_cast<PooledAmountPredicate>(predicatesHandler.FindById(1))->GetAmount(), 5);
+	ASSERT_EQ(newPredicate->GetAmount(), 7);
+	ASSERT_EQ(pool.GetSize(), 1);
+	ASSERT_EQ(pool.GetNumAllocations(), 2);
+}
+
+TEST(NAI_PredicatesPool, When_AcquiringEveryFrameAPredicateTheAgentHolds_Then_NoMoreAllocations)
+{
+	PredicatesPool pool;
+	PredicatesHandler predicatesHandler;
+
+	for (auto frame = 0u; frame < 100; ++frame)
+	{
+		//as a sensor does, publishing what it perceives every frame
+		predicatesHandler.AddOrReplace(pool.Acquire<PooledAmountPredicate>(1, std::string("AMOUNT"), 5u));
+		predicatesHandler.AddOrReplace(pool.Acquire<BasePredicate>(2, std::string("ESCAPE")));
+	}
+
+	ASSERT_EQ(predicatesHandler.GetPredicatesList().size(), 2);
+	ASSERT_EQ(pool.GetSize(), 2);
+	ASSERT_EQ(pool.GetNumAllocations(), 2);
+}
+
+TEST(NAI_PredicatesPool, When_DifferentIdOrType_Then_DifferentPredicates)
+{
+	PredicatesPool pool;
+
+	const auto predicate1 = pool.Acquire<PooledAmountPredicate>(1, std::string("AMOUNT"), 5u);
+	const auto predicate2 = pool.Acquire<PooledAmountPredicate>(2, std::string("AMOUNT"), 5u);
+	const auto predicate3 = pool.Acquire<BasePredicate>(1, std::string("AMOUNT"));
+
+	ASSERT_TRUE(std::static_pointer_cast<IPredicate>(predicate1) != predicate2);
+	ASSERT_TRUE(std::static_pointer_cast<IPredicate>(predicate1) != predicate3);
+	ASSERT_EQ(pool.GetSize(), 3);
+}
+
+TEST(NAI_PredicatesPool, When_Released_Then_OnlyThePredicateOfThatTypeAndIdIsRemoved)
+{
+	PredicatesPool pool;
+
+	pool.Acquire<PooledAmountPredicate>(1, std::string("AMOUNT"), 5u);
+	const auto basePredicate = pool.Acquire<BasePredicate>(1, std::string("AMOUNT")).get();
+
+	pool.Release<PooledAmountPredicate>(1);
+
+	ASSERT_EQ(pool.GetSize(), 1);
+	ASSERT_EQ(pool.Acquire<BasePredicate>(1, std::string("AMOUNT")).get(), basePredicate);
+
+	const auto newPredicate = pool.Acquire<PooledAmountPredicate>(1, std::string("AMOUNT"), 7u);
+
+	ASSERT_EQ(newPredicate->GetAmount(), 7);
+	ASSERT_EQ(pool.GetNumAllocations(), 3);
+}
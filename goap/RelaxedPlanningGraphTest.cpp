@@ -0,0 +1,188 @@
+#include "gtest/gtest.h"
+#include "goap/planners/RelaxedPlanningGraph.h"
+#include "goap/planners/TreeGoapPlanner.h"
+#include "goap/IGoal.h"
+#include "goap/BaseGoal.h"
+#include "goap/IAction.h"
+#include "goap/BaseAction.h"
+#include "goap/IPredicate.h"
+#include "goap/BasePredicate.h"
+#include "GoapTestUtils.h"
+
+#include <algorithm>
+
+using namespace NAI::Goap;
+
+static std::shared_ptr<IGoal> CreateGoalWith(std::vector<std::shared_ptr<IAction>> actions)
+{
+	return std::make_shared<BaseGoal>(actions);
+}
+
+static bool Contains(const std::vector<std::shared_ptr<IGoal>>& goals, const std::shared_ptr<IGoal>& goal)
+{
+	return std::find(goals.begin(), goals.end(), goal) != goals.end();
+}
+
+TEST(NAI_RelaxedPlanningGraph, When_NoGoals_Then_NoViableGoals)
+{
+	const RelaxedPlanningGraph graph({}, { std::make_shared<BasePredicate>(1, "A") });
+
+	ASSERT_TRUE(graph.GetViableGoals().empty());
+}
+
+TEST(NAI_RelaxedPlanningGraph, When_GoalActionsCanNotBeReached_Then_GoalIsDiscarded)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+	auto predicateX = std::make_shared<BasePredicate>(4, "X");
+
+	const auto viableGoal = CreateGoalWith({ CreateActionWith({ predicateA->GetText() }, { predicateB }, 1) });
+	const auto notViableGoal = CreateGoalWith({ CreateActionWith({ predicateX->GetText() }, { predicateC }, 1) });
+
+	const RelaxedPlanningGraph graph({ viableGoal, notViableGoal }, { predicateA });
+
+	const auto viableGoals = graph.GetViableGoals();
+
+	ASSERT_EQ(viableGoals.size(), 1);
+	ASSERT_TRUE(Contains(viableGoals, viableGoal));
+}
+
+TEST(NAI_RelaxedPlanningGraph, When_GoalNeedsAPredicateProducedByAnotherGoal_Then_GoalIsViable)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	const auto goal1 = CreateGoalWith({ CreateActionWith({ predicateA->GetText() }, { predicateB }, 1) });
+	const auto goal2 = CreateGoalWith({ CreateActionWith({ predicateB->GetText() }, { predicateC }, 1) });
+
+	const RelaxedPlanningGraph graph({ goal2, goal1 }, { predicateA });
+
+	const auto viableGoals = graph.GetViableGoals();
+
+	ASSERT_EQ(viableGoals.size(), 2);
+	ASSERT_TRUE(viableGoals[0] == goal2);
+	ASSERT_TRUE(viableGoals[1] == goal1);
+	ASSERT_TRUE(graph.IsReachable(predicateC->GetText()));
+}
+
+TEST(NAI_RelaxedPlanningGraph, When_OneActionOfTheGoalCanNotBeReached_Then_GoalIsDiscarded)
+{
+	const auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	const auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	const auto predicateD = std::make_shared<BasePredicate>(4, "D");
+	const auto predicateE = std::make_shared<BasePredicate>(5, "E");
+
+	//same case TreeGoapPlanner has no plan for
+	const auto goal = CreateGoalWith({
+		CreateActionWith({ predicateD->GetText(), predicateA->GetText() }, { predicateE }, 1),
+		CreateActionWith({ predicateB->GetText() }, { predicateD }, 1) });
+
+	const RelaxedPlanningGraph graph({ goal }, { predicateB });
+
+	ASSERT_TRUE(graph.GetViableGoals().empty());
+}
+
+TEST(NAI_RelaxedPlanningGraph, When_DesiredPredicates_Then_LevelIsTheOneWhereAllOfThemAreReached)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+	auto predicateE = std::make_shared<BasePredicate>(5, "E");
+	auto predicateX = std::make_shared<BasePredicate>(6, "X");
+
+	const auto goal = CreateGoalWith({
+		CreateActionWith({ predicateA->GetText() }, { predicateC }, 1),
+		CreateActionWith({ predicateC->GetText() }, { predicateE }, 1) });
+
+	const RelaxedPlanningGraph graph({ goal }, { predicateA });
+
+	ASSERT_EQ(graph.GetLevel({ predicateA }), 0);
+	ASSERT_EQ(graph.GetLevel({ predicateC }), 1);
+	ASSERT_EQ(graph.GetLevel({ predicateC, predicateE }), 2);
+	ASSERT_EQ(graph.GetLevel({ predicateX }), RelaxedPlanningGraph::UNREACHABLE);
+}
+
+TEST(NAI_RelaxedPlanningGraph, When_DesiredPredicates_Then_HeuristicIsTheCostOfTheMostExpensiveOfThem)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+	auto predicateE = std::make_shared<BasePredicate>(5, "E");
+	auto predicateX = std::make_shared<BasePredicate>(6, "X");
+
+	const auto goal = CreateGoalWith({
+		CreateActionWith({ predicateA->GetText() }, { predicateC }, 2),
+		CreateActionWith({ predicateC->GetText() }, { predicateE }, 3) });
+
+	const RelaxedPlanningGraph graph({ goal }, { predicateA });
+
+	ASSERT_EQ(graph.GetHeuristic({ predicateA }), 0);
+	ASSERT_EQ(graph.GetHeuristic({ predicateC }), 2);
+	ASSERT_EQ(graph.GetHeuristic({ predicateE }), 5);
+	ASSERT_EQ(graph.GetHeuristic({ predicateC, predicateE }), 5);
+	ASSERT_EQ(graph.GetHeuristic({ predicateX }), RelaxedPlanningGraph::UNREACHABLE);
+}
+
+TEST(NAI_RelaxedPlanningGraph, When_SomeWaysToReachAPredicate_Then_HeuristicIsTheCheapestOne)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+	auto predicateE = std::make_shared<BasePredicate>(5, "E");
+
+	//the direct action takes less levels but costs more
+	const auto goal = CreateGoalWith({
+		CreateActionWith({ predicateA->GetText() }, { predicateE }, 10),
+		CreateActionWith({ predicateA->GetText() }, { predicateC }, 1),
+		CreateActionWith({ predicateC->GetText() }, { predicateE }, 1) });
+
+	const RelaxedPlanningGraph graph({ goal }, { predicateA });
+
+	ASSERT_EQ(graph.GetLevel({ predicateE }), 1);
+	ASSERT_EQ(graph.GetHeuristic({ predicateE }), 2);
+}
+
+TEST(NAI_RelaxedPlanningGraph, When_ActionsCostNothing_Then_HeuristicIsZero)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+	auto predicateE = std::make_shared<BasePredicate>(5, "E");
+
+	const auto goal = CreateGoalWith({
+		CreateActionWith({ predicateA->GetText() }, { predicateC }, 0),
+		CreateActionWith({ predicateC->GetText() }, { predicateE }, 0) });
+
+	const RelaxedPlanningGraph graph({ goal }, { predicateA });
+
+	//counting levels would overestimate a plan that costs nothing, so the heuristic is the cost and not the level
+	ASSERT_EQ(graph.GetLevel({ predicateE }), 2);
+	ASSERT_EQ(graph.GetHeuristic({ predicateE }), 0);
+}
+
+TEST(NAI_RelaxedPlanningGraph, When_PlanningOnlyWithViableGoals_Then_SamePlanThanWithAllGoals)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+	auto predicateX = std::make_shared<BasePredicate>(4, "X");
+
+	std::vector<std::shared_ptr<IGoal>> goals;
+	goals.push_back(CreateGoalWith({ CreateActionWith({ predicateB->GetText() }, { predicateC }, 3) }));
+	goals.push_back(CreateGoalWith({ CreateActionWith({ predicateA->GetText() }, { predicateC }, 1) }));
+	for (auto i = 0; i < 20; ++i)
+	{
+		goals.push_back(CreateGoalWith({ CreateActionWith({ predicateX->GetText() }, { predicateC }, 1) }));
+	}
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+
+	const RelaxedPlanningGraph graph(goals, predicates);
+	auto viableGoals = graph.GetViableGoals();
+
+	ASSERT_EQ(viableGoals.size(), 2);
+
+	auto planner = std::make_shared<TreeGoapPlanner>();
+	const auto plan = planner->GetPlan(viableGoals, predicates);
+
+	ASSERT_TRUE(plan != nullptr);
+	ASSERT_EQ(plan->GetCost(), 1);
+}
@@ -0,0 +1,178 @@
+#include "gtest/gtest.h"
+#include "goap/planners/StaticGoapPlanner.h"
+#include "goap/IGoapPlanner.h"
+#include "goap/BaseGoal.h"
+#include "goap/BaseAction.h"
+#include "goap/BasePredicate.h"
+#include "goap/agent/BaseAgent.h"
+#include "goap/agent/AgentBuilder.h"
+#include "GoapTestUtils.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+using namespace NAI::Goap;
+
+//Same domain than the chicken of ChikenTest: it eats when there is food, and it escapes when there is danger.
+struct ChickenDomain
+{
+	enum Predicate : unsigned int { FOOD, ESCAPE, NUM_PREDICATES };
+	enum Goal : unsigned int { EAT_GOAL, ESCAPE_GOAL, NUM_GOALS };
+
+	static constexpr std::array<const char*, NUM_PREDICATES> GetPredicateTexts()
+	{
+		return {{ "FOOD", "ESCAPE" }};
+	}
+
+	static constexpr std::array<StaticAction, 2> GetActions()
+	{
+		return {{
+			{ MaskOf(FOOD), 0, 2 },		//eat
+			{ MaskOf(ESCAPE), 0, 1 }	//escape
+		}};
+	}
+
+	static constexpr std::array<StaticGoal, NUM_GOALS> GetGoals()
+	{
+		return {{ { 0, 1 }, { 1, 1 } }};
+	}
+};
+
+//One goal with two chained actions: A -> B and B -> C, declared in the opposite order.
+struct ChainDomain
+{
+	enum Predicate : unsigned int { A, B, C, NUM_PREDICATES };
+
+	static constexpr std::array<const char*, NUM_PREDICATES> GetPredicateTexts()
+	{
+		return {{ "A", "B", "C" }};
+	}
+
+	static constexpr std::array<StaticAction, 2> GetActions()
+	{
+		return {{
+			{ MaskOf(B), MaskOf(C), 1 },
+			{ MaskOf(A), MaskOf(B), 1 }
+		}};
+	}
+
+	static constexpr std::array<StaticGoal, 1> GetGoals()
+	{
+		return {{ { 0, 2 } }};
+	}
+};
+
+TEST(NAI_StaticGoapPlanner, When_NoPredicates_Then_NoPlan)
+{
+	constexpr auto plan = StaticGoapPlanner<ChickenDomain>::GetPlan(0);
+
+	static_assert(!plan.IsValid(), "there is nothing to plan for without predicates");
+}
+
+TEST(NAI_StaticGoapPlanner, When_Food_Then_EatPlanIsBuiltAtCompileTime)
+{
+	constexpr auto plan = StaticGoapPlanner<ChickenDomain>::GetPlan(MaskOf(ChickenDomain::FOOD));
+
+	static_assert(plan.IsValid(), "food must give a plan");
+	static_assert(plan.goal == ChickenDomain::EAT_GOAL, "food must give the eat plan");
+	static_assert(plan.numActions == 1, "eating is one action");
+	static_assert(plan.cost == 2, "eating costs 2");
+}
+
+TEST(NAI_StaticGoapPlanner, When_FoodAndDanger_Then_LessCostGoalPlan)
+{
+	constexpr auto plan = StaticGoapPlanner<ChickenDomain>::GetPlan(MaskOf(ChickenDomain::FOOD, ChickenDomain::ESCAPE));
+
+	static_assert(plan.IsValid(), "food and danger must give a plan");
+	static_assert(plan.goal == ChickenDomain::ESCAPE_GOAL, "escaping is cheaper than eating");
+	static_assert(plan.cost == 1, "escaping costs 1");
+}
+
+TEST(NAI_StaticGoapPlanner, When_OnePredicateChainsTwoActionsOfTheSameGoal_Then_ActionsAreOrdered)
+{
+	constexpr auto plan = StaticGoapPlanner<ChainDomain>::GetPlan(MaskOf(ChainDomain::A));
+
+	static_assert(plan.IsValid(), "A chains both actions");
+	static_assert(plan.numActions == 2, "the goal has two actions");
+	static_assert(plan.actions[0] == 1, "A -> B goes first");
+	static_assert(plan.actions[1] == 0, "B -> C goes second");
+	static_assert(plan.cost == 2, "both actions cost 1");
+}
+
+TEST(NAI_StaticGoapPlanner, When_OneActionOfTheGoalCanNotBeSatisfied_Then_NoPlan)
+{
+	constexpr auto plan = StaticGoapPlanner<ChainDomain>::GetPlan(MaskOf(ChainDomain::C));
+
+	static_assert(!plan.IsValid(), "C doesn't satisfy any action");
+}
+
+TEST(NAI_StaticGoapPlanner, When_UsedAsIGoapPlanner_Then_ReturnsTheAgentGoalOfTheDomainPlan)
+{
+	std::vector<std::shared_ptr<IAction>> eatActions = { std::make_shared<BaseAction>(std::vector<std::string>{ "FOOD" }, std::vector<std::shared_ptr<IPredicate>>{}) };
+	std::vector<std::shared_ptr<IAction>> escapeActions = { std::make_shared<BaseAction>(std::vector<std::string>{ "ESCAPE" }, std::vector<std::shared_ptr<IPredicate>>{}) };
+
+	//goals must be in the same order than the domain goals
+	std::vector<std::shared_ptr<IGoal>> goals = { std::make_shared<BaseGoal>(eatActions), std::make_shared<BaseGoal>(escapeActions) };
+	std::vector<std::shared_ptr<IPredicate>> predicates = { std::make_shared<BasePredicate>(1, "FOOD"), std::make_shared<BasePredicate>(3, "UNKNOWN") };
+
+	const std::shared_ptr<IGoapPlanner> planner = std::make_shared<StaticDomainGoapPlanner<ChickenDomain>>();
+
+	const auto plan = planner->GetPlan(goals, predicates);
+
+	ASSERT_TRUE(plan == goals[ChickenDomain::EAT_GOAL]);
+}
+
+class ChickenAgentMock : public BaseAgent
+{
+public:
+	ChickenAgentMock(const std::shared_ptr<IGoapPlanner> goapPlanner,
+		const std::vector<std::shared_ptr<IGoal>>& goals,
+		const std::vector<std::shared_ptr<IPredicate>>& predicates) :
+	ChickenAgentMock(goapPlanner, goals, predicates, nullptr)
+	{
+	}
+
+	ChickenAgentMock(const std::shared_ptr<IGoapPlanner> goapPlanner,
+		const std::vector<std::shared_ptr<IGoal>>& goals,
+		const std::vector<std::shared_ptr<IPredicate>>& predicates,
+		const std::shared_ptr<PerceptionSystem> perceptionSystem) :
+	BaseAgent(goapPlanner, goals, predicates, perceptionSystem)
+	{
+	}
+
+	virtual ~ChickenAgentMock() = default;
+
+	glm::vec3 GetPosition() const override { return glm::vec3(0.0f); }
+	void MoveTo(float elapsedTime, const glm::vec3& point) override {}
+};
+
+TEST(NAI_StaticGoapPlanner, When_AgentPlansWithItThroughIGoapPlanner_Then_ProcessesTheDomainPlan)
+{
+	const auto predicateFull = std::make_shared<BasePredicate>(2, "FULL");
+	std::vector<std::shared_ptr<IAction>> eatActions = { CreateActionWith({ "FOOD" }, { predicateFull }, 2) };
+	std::vector<std::shared_ptr<IAction>> escapeActions = { CreateActionWith({ "ESCAPE" }, {}, 1) };
+
+	//goals must be in the same order than the domain goals
+	AgentBuilder agentBuilder;
+	auto agent =	agentBuilder.WithGoapPlanner(std::make_shared<StaticDomainGoapPlanner<ChickenDomain>>())
+								.WithGoal(std::make_shared<BaseGoal>(eatActions))
+								.WithGoal(std::make_shared<BaseGoal>(escapeActions))
+								.WithPredicate(std::make_shared<BasePredicate>(1, "FOOD"))
+								.Build<ChickenAgentMock>();
+
+	agent->Update(0.0f); //-->gets the eat plan
+	ASSERT_TRUE(agent->GetCurrentState() == AgentState::STATE_PROCESSING);
+
+	agent->Update(0.0f); //-->eats
+	ASSERT_TRUE(agent->HasPredicate(predicateFull->GetID()));
+}
+
+TEST(NAI_StaticGoapPlanner, When_PredicatesAreNotInTheDomain_Then_TheyAreIgnoredInTheMask)
+{
+	std::vector<std::shared_ptr<IPredicate>> predicates = { std::make_shared<BasePredicate>(1, "ESCAPE"), std::make_shared<BasePredicate>(2, "UNKNOWN") };
+
+	const auto mask = StaticDomainGoapPlanner<ChickenDomain>::GetMaskOf(predicates);
+
+	ASSERT_EQ(mask, MaskOf(ChickenDomain::ESCAPE));
+}
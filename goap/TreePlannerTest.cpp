@@ -6,13 +6,18 @@
 #include "goap/BaseAction.h"
 #include "goap/IPredicate.h"
 #include "goap/BasePredicate.h"
+#ifdef NAI_NEXT_API
+#include "goap/IPlanningSearch.h"
+#include "goap/PlanningBudget.h"
+#include "goap/planners/PlanningStats.h"
+#include "goap/PredicatesSnapshot.h"
+#endif
+#include "GoapTestUtils.h"
 
-using namespace NAI::Goap;
+#include <limits>
+#include <thread>
 
-std::shared_ptr<IAction> CreateActionWith(std::vector<std::string> preconditions, std::vector<std::shared_ptr<IPredicate>> postconditions, unsigned int cost)
-{
-	return std::make_shared<BaseAction>(preconditions, postconditions, cost);
-}
+using namespace NAI::Goap;
 
 TEST(NAI_TreeGoalPlanner, When_NoPredicates_Then_NoPlan) 
 {
@@ -431,4 +436,433 @@ TEST(NAI_TreeGoalPlanner, When_WeWantAPlanThatSatisfiesAGivenPredicateWithMoreTh
 	ASSERT_TRUE(!plan.empty());
 	ASSERT_EQ(plan[0]->GetCost(), 3);
 	ASSERT_EQ(plan[1]->GetCost(), 2);
-}
\ No newline at end of file
+}
+
+#ifdef NAI_NEXT_API
+TEST(NAI_TreeGoalPlanner, When_WeWantAPlanThatSatisfiesAGivenPredicateWithMoreThanOneGoalInParallel_Then_SamePlanThanSerial)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+	auto predicateD = std::make_shared<BasePredicate>(4, "D");
+	auto predicateE = std::make_shared<BasePredicate>(5, "E");
+	auto predicateF = std::make_shared<BasePredicate>(6, "F");
+	auto predicateG = std::make_shared<BasePredicate>(7, "G");
+
+	auto action1 = CreateActionWith({ predicateA->GetText() }, { predicateC }, 1);
+	auto action2 = CreateActionWith({ predicateC->GetText() }, { predicateE }, 1);
+	auto action3 = CreateActionWith({ predicateA->GetText(), predicateE->GetText() }, { predicateF }, 1);
+	auto action4 = CreateActionWith({ predicateB->GetText() }, { predicateD }, 1);
+	auto action5 = CreateActionWith({ predicateC->GetText(), predicateD->GetText() }, { predicateG }, 1);
+	auto action6 = CreateActionWith({ predicateA->GetText() }, { predicateF }, 4);
+	auto action7 = CreateActionWith({ predicateB->GetText(), predicateF->GetText() }, { predicateG }, 4);
+
+	std::vector<std::shared_ptr<IAction>> actions = { action1, action2, action3 };
+	auto goal1 = std::make_shared<BaseGoal>(actions);
+	actions = { action4, action5 };
+	auto goal2 = std::make_shared<BaseGoal>(actions);
+	actions = { action6, action7 };
+	auto goal3 = std::make_shared<BaseGoal>(actions);
+
+	std::vector<std::shared_ptr<IGoal>> goals = { goal1, goal2, goal3 };
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+	std::vector<std::shared_ptr<IPredicate>> desiredPredicates = { predicateF, predicateG };
+
+	auto serialPredicates = predicates;
+	const auto serialPlan = std::make_shared<TreeGoapPlanner>()->GetPlanToReach(goals, serialPredicates, desiredPredicates);
+
+	const unsigned int numThreads = 4;
+	auto parallelPredicates = predicates;
+	const auto parallelPlan = std::make_shared<TreeGoapPlanner>(numThreads)->GetPlanToReach(goals, parallelPredicates, desiredPredicates);
+
+	ASSERT_FALSE(serialPlan.empty());
+	ASSERT_EQ(parallelPlan, serialPlan);
+}
+
+TEST(NAI_TreeGoalPlanner, When_GetPlanToReachInParallel_Then_SamePlanThanSerial)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+	auto predicateD = std::make_shared<BasePredicate>(4, "D");
+
+	//several goals with the same cost reaching the desired predicates, so the order is what decides
+	std::vector<std::shared_ptr<IGoal>> goals;
+	for (auto i = 0; i < 8; ++i)
+	{
+		std::vector<std::shared_ptr<IAction>> actions = { CreateActionWith({ predicateA->GetText() }, { predicateC }, 1 + i % 2) };
+		goals.push_back(std::make_shared<BaseGoal>(actions));
+		actions = { CreateActionWith({ predicateB->GetText() }, { predicateD }, 1 + i % 3) };
+		goals.push_back(std::make_shared<BaseGoal>(actions));
+	}
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+	std::vector<std::shared_ptr<IPredicate>> desiredPredicates = { predicateC, predicateD };
+
+	auto serialPredicates = predicates;
+	const auto serialPlan = std::make_shared<TreeGoapPlanner>()->GetPlanToReach(goals, serialPredicates, desiredPredicates);
+
+	ASSERT_FALSE(serialPlan.empty());
+
+	const auto parallelPlanner = std::make_shared<TreeGoapPlanner>(4);
+	for (auto i = 0; i < 20; ++i)
+	{
+		auto parallelPredicates = predicates;
+		const auto parallelPlan = parallelPlanner->GetPlanToReach(goals, parallelPredicates, desiredPredicates);
+
+		ASSERT_EQ(parallelPlan, serialPlan);
+	}
+}
+
+//two goals reaching C: one needs B and costs 3, the other one needs A and costs 1
+static std::vector<std::shared_ptr<IGoal>> CreateTwoGoalsWithDifferentCost(const std::shared_ptr<IPredicate>& predicateA, const std::shared_ptr<IPredicate>& predicateB)
+{
+	auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	std::vector<std::shared_ptr<IGoal>> goals;
+	std::vector<std::shared_ptr<IAction>> actions = { CreateActionWith({ predicateB->GetText() }, { predicateC }, 3) };
+	goals.push_back(std::make_shared<BaseGoal>(actions));
+
+	actions = { CreateActionWith({ predicateA->GetText() }, { predicateC }, 1) };
+	goals.push_back(std::make_shared<BaseGoal>(actions));
+
+	return goals;
+}
+
+TEST(NAI_TreeGoalPlanner, When_BudgetIsEnough_Then_SearchIsFinishedWithLessCostGoalPlan)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto goals = CreateTwoGoalsWithDifferentCost(predicateA, predicateB);
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+
+	auto planner = std::make_shared<TreeGoapPlanner>();
+
+	const auto search = planner->GetPlan(goals, predicates, PlanningBudget::WithMaxExpandedNodes(1000));
+
+	ASSERT_TRUE(search != nullptr);
+	ASSERT_TRUE(search->IsFinished());
+	ASSERT_TRUE(search->GetBestPlan() != nullptr);
+	ASSERT_EQ(search->GetBestPlan()->GetCost(), 1);
+}
+
+TEST(NAI_TreeGoalPlanner, When_BudgetIsExhausted_Then_SearchCanBeResumedUntilLessCostGoalPlan)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto goals = CreateTwoGoalsWithDifferentCost(predicateA, predicateB);
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+
+	auto planner = std::make_shared<TreeGoapPlanner>();
+	const auto budget = PlanningBudget::WithMaxExpandedNodes(1);
+
+	const auto search = planner->GetPlan(goals, predicates, budget);
+
+	ASSERT_TRUE(search != nullptr);
+	ASSERT_FALSE(search->IsFinished());
+
+	auto numResumes = 0;
+	auto previousCost = std::numeric_limits<unsigned int>::max();
+	while (!search->IsFinished() && numResumes < 100)
+	{
+		//the best plan so far can only get cheaper
+		const auto bestPlanSoFar = search->GetBestPlan();
+		if (bestPlanSoFar)
+		{
+			ASSERT_LE(bestPlanSoFar->GetCost(), previousCost);
+			previousCost = bestPlanSoFar->GetCost();
+		}
+		search->Resume(budget);
+		++numResumes;
+	}
+
+	ASSERT_TRUE(search->IsFinished());
+	ASSERT_EQ(search->GetBestPlan()->GetCost(), 1);
+}
+
+TEST(NAI_TreeGoalPlanner, When_DeadlineIsNotReached_Then_SearchIsFinishedInOneCall)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto goals = CreateTwoGoalsWithDifferentCost(predicateA, predicateB);
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+
+	auto planner = std::make_shared<TreeGoapPlanner>();
+	//the clock never advances
+	const auto budget = PlanningBudget::WithDeadline(1.0f, []() { return 0.0f; });
+
+	const auto search = planner->GetPlan(goals, predicates, budget);
+
+	ASSERT_TRUE(search->IsFinished());
+	ASSERT_EQ(search->GetBestPlan()->GetCost(), 1);
+}
+
+TEST(NAI_TreeGoalPlanner, When_DeadlineIsReached_Then_SearchCanBeResumedUntilLessCostGoalPlan)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto goals = CreateTwoGoalsWithDifferentCost(predicateA, predicateB);
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+
+	auto planner = std::make_shared<TreeGoapPlanner>();
+	//the deadline is over as soon as the search starts, however many times the clock is read
+	auto isStarted = false;
+	const auto expiredBudget = PlanningBudget::WithDeadline(1.0f, [&isStarted]()
+	{
+		const auto timeMs = isStarted ? 2.0f : 0.0f;
+		isStarted = true;
+		return timeMs;
+	});
+
+	const auto search = planner->GetPlan(goals, predicates, expiredBudget);
+
+	//the deadline only guarantees a handle with the best plan so far that can be resumed
+	ASSERT_TRUE(search != nullptr);
+	if (search->GetBestPlan())
+	{
+		ASSERT_GE(search->GetBestPlan()->GetCost(), 1);
+	}
+
+	const auto budget = PlanningBudget::WithDeadline(1.0f, []() { return 0.0f; });
+	search->Resume(budget);
+
+	ASSERT_TRUE(search->IsFinished());
+	ASSERT_EQ(search->GetBestPlan()->GetCost(), 1);
+}
+
+TEST(NAI_TreeGoalPlanner, When_NoPlanAndBudget_Then_SearchIsFinishedWithoutPlan)
+{
+	std::vector<std::shared_ptr<IGoal>> goals;
+	std::vector<std::shared_ptr<IPredicate>> predicates = { std::make_shared<BasePredicate>(1, "A") };
+
+	auto planner = std::make_shared<TreeGoapPlanner>();
+
+	const auto search = planner->GetPlan(goals, predicates, PlanningBudget::WithMaxExpandedNodes(1));
+
+	ASSERT_TRUE(search->IsFinished());
+	ASSERT_EQ(search->GetBestPlan(), nullptr);
+}
+
+TEST(NAI_TreeGoalPlanner, When_Plan_Then_SearchNodesComeFromTheArena)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto goals = CreateTwoGoalsWithDifferentCost(predicateA, predicateB);
+
+	auto planner = std::make_shared<TreeGoapPlanner>();
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+	PlanningStats stats;
+	const auto plan = planner->GetPlan(goals, predicates, stats);
+
+	ASSERT_TRUE(plan != nullptr);
+	ASSERT_GT(stats.numArenaAllocations, 0);
+	ASSERT_GT(stats.arenaPeakUsedBytes, 0);
+}
+
+TEST(NAI_TreeGoalPlanner, When_SamePlanTwice_Then_ArenaIsResetAndReusedWithoutGrowing)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto goals = CreateTwoGoalsWithDifferentCost(predicateA, predicateB);
+
+	auto planner = std::make_shared<TreeGoapPlanner>();
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+	PlanningStats firstStats;
+	planner->GetPlan(goals, predicates, firstStats);
+
+	predicates = { predicateA, predicateB };
+	PlanningStats secondStats;
+	planner->GetPlan(goals, predicates, secondStats);
+
+	//stats are of each call, not accumulated
+	ASSERT_EQ(secondStats.numArenaAllocations, firstStats.numArenaAllocations);
+	ASSERT_EQ(secondStats.arenaPeakUsedBytes, firstStats.arenaPeakUsedBytes);
+	ASSERT_EQ(secondStats.arenaCapacity, firstStats.arenaCapacity);
+}
+
+TEST(NAI_TreeGoalPlanner, When_TwoThreadsUseTheSamePlannerAtTheSameTime_Then_EachOneGetsItsPlanAndStats)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+
+	const auto planner = std::make_shared<TreeGoapPlanner>();
+
+	auto serialGoals = CreateTwoGoalsWithDifferentCost(predicateA, predicateB);
+	std::vector<std::shared_ptr<IPredicate>> serialPredicates = { predicateA, predicateB };
+	PlanningStats serialStats;
+	planner->GetPlan(serialGoals, serialPredicates, serialStats);
+
+	const auto numPlansPerThread = 200;
+	bool allPlansOk[2] = { true, true };
+	std::vector<std::thread> threads;
+	for (auto i = 0; i < 2; ++i)
+	{
+		threads.emplace_back([&, i]()
+		{
+			auto goals = CreateTwoGoalsWithDifferentCost(predicateA, predicateB);
+			for (auto j = 0; j < numPlansPerThread; ++j)
+			{
+				std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+				PlanningStats stats;
+				const auto plan = planner->GetPlan(goals, predicates, stats);
+
+				allPlansOk[i] = allPlansOk[i] &&
+					plan == goals[1] &&
+					stats.numExpandedNodes == serialStats.numExpandedNodes &&
+					stats.numArenaAllocations == serialStats.numArenaAllocations;
+			}
+		});
+	}
+	for (auto&& thread : threads)
+	{
+		thread.join();
+	}
+
+	ASSERT_TRUE(allPlansOk[0]);
+	ASSERT_TRUE(allPlansOk[1]);
+}
+
+static std::vector<std::shared_ptr<IGoal>> CreateCheapGoalAndExpensiveChainGoals(std::shared_ptr<IPredicate> predicateA, unsigned int numChainGoals)
+{
+	auto predicateD = std::make_shared<BasePredicate>(4, "D");
+
+	std::vector<std::shared_ptr<IGoal>> goals;
+	for (unsigned int i = 0; i < numChainGoals; ++i)
+	{
+		auto predicateB = std::make_shared<BasePredicate>(10 + i * 2, "B" + std::to_string(i));
+		auto predicateC = std::make_shared<BasePredicate>(11 + i * 2, "C" + std::to_string(i));
+
+		std::vector<std::shared_ptr<IAction>> actions = {
+			CreateActionWith({ predicateA->GetText() }, { predicateB }, 5),
+			CreateActionWith({ predicateB->GetText() }, { predicateC }, 5),
+			CreateActionWith({ predicateC->GetText() }, { predicateD }, 5) };
+		goals.push_back(std::make_shared<BaseGoal>(actions));
+	}
+
+	std::vector<std::shared_ptr<IAction>> actions = { CreateActionWith({ predicateA->GetText() }, { predicateD }, 1) };
+	goals.push_back(std::make_shared<BaseGoal>(actions));
+
+	return goals;
+}
+
+TEST(NAI_TreeGoalPlanner, When_BranchAndBound_Then_SameLessCostGoalPlan)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	auto goals = CreateTwoGoalsWithDifferentCost(predicateA, predicateB);
+
+	auto planner = std::make_shared<TreeGoapPlanner>();
+	auto boundedPlanner = std::make_shared<TreeGoapPlanner>();
+	boundedPlanner->SetBranchAndBound(true);
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA, predicateB };
+	const auto plan = planner->GetPlan(goals, predicates);
+
+	predicates = { predicateA, predicateB };
+	const auto boundedPlan = boundedPlanner->GetPlan(goals, predicates);
+
+	ASSERT_TRUE(boundedPlan != nullptr);
+	ASSERT_TRUE(boundedPlan == plan);
+	ASSERT_EQ(boundedPlan->GetCost(), 1);
+}
+
+TEST(NAI_TreeGoalPlanner, When_BranchAndBoundAndExpensiveGoals_Then_TheirBranchesArePrunedWithSamePlan)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto goals = CreateCheapGoalAndExpensiveChainGoals(predicateA, 10);
+
+	auto planner = std::make_shared<TreeGoapPlanner>();
+	auto boundedPlanner = std::make_shared<TreeGoapPlanner>();
+	boundedPlanner->SetBranchAndBound(true);
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateA };
+	PlanningStats stats;
+	const auto plan = planner->GetPlan(goals, predicates, stats);
+
+	predicates = { predicateA };
+	PlanningStats boundedStats;
+	const auto boundedPlan = boundedPlanner->GetPlan(goals, predicates, boundedStats);
+
+	ASSERT_TRUE(boundedPlan == plan);
+	ASSERT_TRUE(boundedPlan == goals.back());
+	ASSERT_EQ(boundedPlan->GetCost(), 1);
+	ASSERT_LT(boundedStats.numExpandedNodes, stats.numExpandedNodes);
+}
+
+TEST(NAI_TreeGoalPlanner, When_BranchAndBoundAndNoPlan_Then_NoPlan)
+{
+	auto predicateX = std::make_shared<BasePredicate>(5, "X");
+	auto goals = CreateCheapGoalAndExpensiveChainGoals(std::make_shared<BasePredicate>(1, "A"), 3);
+
+	auto boundedPlanner = std::make_shared<TreeGoapPlanner>();
+	boundedPlanner->SetBranchAndBound(true);
+
+	std::vector<std::shared_ptr<IPredicate>> predicates = { predicateX };
+	const auto plan = boundedPlanner->GetPlan(goals, predicates);
+
+	ASSERT_EQ(plan, nullptr);
+}
+
+TEST(NAI_TreeGoalPlanner, When_PlanningWithASnapshot_Then_SamePlanAndPredicatesAreNotReordered)
+{
+	const auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	const auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	const auto predicateD = std::make_shared<BasePredicate>(4, "D");
+	const auto predicateE = std::make_shared<BasePredicate>(5, "E");
+	const auto predicateF = std::make_shared<BasePredicate>(6, "F");
+
+	std::vector<std::shared_ptr<IAction>> actions = {
+		CreateActionWith({ predicateD->GetText(), predicateA->GetText() }, { predicateE }, 1),
+		CreateActionWith({ predicateB->GetText() }, { predicateD }, 1) };
+	std::vector<std::shared_ptr<IGoal>> goals = { std::make_shared<BaseGoal>(actions) };
+
+	auto planner = std::make_shared<TreeGoapPlanner>();
+
+	const PredicatesSnapshot snapshot({ predicateF, predicateA, predicateB });
+	const auto plan = planner->GetPlan(goals, snapshot);
+
+	ASSERT_TRUE(plan);
+	ASSERT_EQ(plan->GetCost(), 2);
+	ASSERT_TRUE(snapshot.GetPredicates()[0] == predicateF);
+	ASSERT_TRUE(snapshot.GetPredicates()[1] == predicateA);
+	ASSERT_TRUE(snapshot.GetPredicates()[2] == predicateB);
+}
+
+TEST(NAI_TreeGoalPlanner, When_PlanningWithTheSameSnapshotFromSomeThreads_Then_AllOfThemGetTheLessCostGoalPlan)
+{
+	auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	const PredicatesSnapshot snapshot({ predicateA, predicateB });
+
+	const auto numThreads = 4;
+	std::vector<std::vector<std::shared_ptr<IGoal>>> goalsPerThread;
+	for (auto i = 0; i < numThreads; ++i)
+	{
+		goalsPerThread.push_back(CreateTwoGoalsWithDifferentCost(predicateA, predicateB));
+	}
+
+	std::vector<std::shared_ptr<IGoal>> plans(numThreads);
+	std::vector<std::thread> threads;
+	for (auto i = 0; i < numThreads; ++i)
+	{
+		threads.emplace_back([&, i]()
+		{
+			TreeGoapPlanner planner;
+			plans[i] = planner.GetPlan(goalsPerThread[i], snapshot);
+		});
+	}
+	for (auto&& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (auto i = 0; i < numThreads; ++i)
+	{
+		ASSERT_TRUE(plans[i] == goalsPerThread[i][1]);
+	}
+	ASSERT_TRUE(snapshot.GetPredicates()[0] == predicateA);
+}
+#endif
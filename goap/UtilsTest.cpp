@@ -20,4 +20,146 @@ TEST(Utils_Substract, When_FirstVectorHasRepeatedPredicates_Substract_ResultEmpt
 
     const auto result = NAI::Goap::Utils::Substract(v1, v2);
     ASSERT_EQ(result.size(), 0);
-}
\ No newline at end of file
+}
+
+TEST(Utils_Substract, When_SecondVectorHasPredicatesNotInTheFirstOne_Substract_KeepsTheOthersInOrder)
+{
+    std::vector<std::shared_ptr<NAI::Goap::IPredicate>> v1 = {
+        std::make_shared<NAI::Goap::BasePredicate>(1, "A"),
+        std::make_shared<NAI::Goap::BasePredicate>(2, "B"),
+        std::make_shared<NAI::Goap::BasePredicate>(3, "C")
+    };
+
+    std::vector<std::shared_ptr<NAI::Goap::IPredicate>> v2 = {
+        std::make_shared<NAI::Goap::BasePredicate>(2, "B"),
+        std::make_shared<NAI::Goap::BasePredicate>(4, "D")
+    };
+
+    const auto result = NAI::Goap::Utils::Substract(v1, v2);
+    ASSERT_EQ(result.size(), 2);
+    ASSERT_EQ(result[0]->GetText(), "A");
+    ASSERT_EQ(result[1]->GetText(), "C");
+}
+
+TEST(Utils_RemovePredicateWith, When_SomePredicatesHaveTheText_RemovePredicateWith_RemovesAllOfThem)
+{
+    std::vector<std::shared_ptr<NAI::Goap::IPredicate>> predicates = {
+        std::make_shared<NAI::Goap::BasePredicate>(1, "A"),
+        std::make_shared<NAI::Goap::BasePredicate>(2, "B"),
+        std::make_shared<NAI::Goap::BasePredicate>(1, "A")
+    };
+
+    NAI::Goap::Utils::RemovePredicateWith(predicates, "A");
+    ASSERT_EQ(predicates.size(), 1);
+    ASSERT_EQ(predicates[0]->GetText(), "B");
+}
+
+#ifdef NAI_NEXT_API
+TEST(Utils_Substract, When_InPlace_Then_SameResultThanSubstractReusingTheVectorCapacity)
+{
+    std::vector<std::shared_ptr<NAI::Goap::IPredicate>> v1 = {
+        std::make_shared<NAI::Goap::BasePredicate>(1, "A"),
+        std::make_shared<NAI::Goap::BasePredicate>(2, "B"),
+        std::make_shared<NAI::Goap::BasePredicate>(1, "A"),
+        std::make_shared<NAI::Goap::BasePredicate>(3, "C")
+    };
+
+    std::vector<std::shared_ptr<NAI::Goap::IPredicate>> v2 = {
+        std::make_shared<NAI::Goap::BasePredicate>(1, "A")
+    };
+
+    const auto result = NAI::Goap::Utils::Substract(v1, v2);
+    const auto capacity = v1.capacity();
+    NAI::Goap::Utils::SubstractInPlace(v1, v2);
+
+    ASSERT_EQ(v1, result);
+    ASSERT_EQ(v1.capacity(), capacity);
+}
+
+TEST(Utils_Intersection, When_FirstVectorHasRepeatedPredicates_Intersection_KeepsAllOfThem)
+{
+    std::vector<std::shared_ptr<NAI::Goap::IPredicate>> v1 = {
+        std::make_shared<NAI::Goap::BasePredicate>(1, "A"),
+        std::make_shared<NAI::Goap::BasePredicate>(2, "B"),
+        std::make_shared<NAI::Goap::BasePredicate>(1, "A"),
+        std::make_shared<NAI::Goap::BasePredicate>(3, "C")
+    };
+
+    std::vector<std::shared_ptr<NAI::Goap::IPredicate>> v2 = {
+        std::make_shared<NAI::Goap::BasePredicate>(1, "A"),
+        std::make_shared<NAI::Goap::BasePredicate>(4, "D")
+    };
+
+    const auto result = NAI::Goap::Utils::Intersection(v1, v2);
+    ASSERT_EQ(result.size(), 2);
+    ASSERT_TRUE(result[0] == v1[0]);
+    ASSERT_TRUE(result[1] == v1[2]);
+
+    NAI::Goap::Utils::IntersectionInPlace(v1, v2);
+    ASSERT_EQ(v1, result);
+}
+
+TEST(Utils_Union, When_BothVectorsHaveTheSamePredicate_Union_AddsItOnce)
+{
+    std::vector<std::shared_ptr<NAI::Goap::IPredicate>> v1 = {
+        std::make_shared<NAI::Goap::BasePredicate>(1, "A"),
+        std::make_shared<NAI::Goap::BasePredicate>(2, "B")
+    };
+
+    std::vector<std::shared_ptr<NAI::Goap::IPredicate>> v2 = {
+        std::make_shared<NAI::Goap::BasePredicate>(2, "B"),
+        std::make_shared<NAI::Goap::BasePredicate>(3, "C"),
+        std::make_shared<NAI::Goap::BasePredicate>(3, "C")
+    };
+
+    const auto result = NAI::Goap::Utils::Union(v1, v2);
+    ASSERT_EQ(result.size(), 3);
+    ASSERT_TRUE(result[0] == v1[0]);
+    ASSERT_TRUE(result[1] == v1[1]);
+    ASSERT_TRUE(result[2] == v2[1]);
+
+    NAI::Goap::Utils::UnionInPlace(v1, v2);
+    ASSERT_EQ(v1, result);
+}
+
+TEST(Utils_Union, When_FirstVectorHasRepeatedPredicates_Union_KeepsAllOfThem)
+{
+    std::vector<std::shared_ptr<NAI::Goap::IPredicate>> v1 = {
+        std::make_shared<NAI::Goap::BasePredicate>(1, "A"),
+        std::make_shared<NAI::Goap::BasePredicate>(1, "A"),
+        std::make_shared<NAI::Goap::BasePredicate>(2, "B")
+    };
+
+    std::vector<std::shared_ptr<NAI::Goap::IPredicate>> v2 = {
+        std::make_shared<NAI::Goap::BasePredicate>(1, "A"),
+        std::make_shared<NAI::Goap::BasePredicate>(3, "C")
+    };
+
+    //the first vector is kept as it is, only texts it doesn't have are added
+    const auto result = NAI::Goap::Utils::Union(v1, v2);
+    ASSERT_EQ(result.size(), 4);
+    ASSERT_TRUE(result[0] == v1[0]);
+    ASSERT_TRUE(result[1] == v1[1]);
+    ASSERT_TRUE(result[2] == v1[2]);
+    ASSERT_TRUE(result[3] == v2[1]);
+
+    NAI::Goap::Utils::UnionInPlace(v1, v2);
+    ASSERT_EQ(v1, result);
+}
+
+TEST(Utils_RemovePredicatesWith, When_RemovingSomeTexts_RemovePredicatesWith_KeepsTheOthersInOrder)
+{
+    std::vector<std::shared_ptr<NAI::Goap::IPredicate>> predicates;
+    for (auto i = 0; i < 100; ++i)
+    {
+        predicates.push_back(std::make_shared<NAI::Goap::BasePredicate>(i, std::to_string(i % 4)));
+    }
+
+    NAI::Goap::Utils::RemovePredicatesWith(predicates, { "0", "2", "not a predicate" });
+    ASSERT_EQ(predicates.size(), 50);
+    for (size_t i = 0; i < predicates.size(); ++i)
+    {
+        ASSERT_EQ(predicates[i]->GetID(), static_cast<int>(i * 2 + 1));
+    }
+}
+#endif
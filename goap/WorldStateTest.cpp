@@ -0,0 +1,156 @@
+#include "gtest/gtest.h"
+#include "goap/WorldState.h"
+#include "goap/BaseAction.h"
+#include "goap/IPredicate.h"
+#include "goap/BasePredicate.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace NAI::Goap;
+
+//Predicate that carries some data besides its text.
+class AmountPredicate : public BasePredicate
+{
+public:
+	AmountPredicate(int id, const std::string& text, unsigned int amount) : BasePredicate(id, text), mAmount{ amount } {}
+	virtual ~AmountPredicate() = default;
+
+	unsigned int GetAmount() const { return mAmount; }
+
+private:
+	unsigned int mAmount;
+};
+
+TEST(NAI_WorldState, When_Created_Then_IsEmpty)
+{
+	const WorldState worldState;
+
+	ASSERT_TRUE(worldState.IsEmpty());
+}
+
+TEST(NAI_WorldState, When_CreatedFromPredicates_Then_HasAllOfThem)
+{
+	const auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	const auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	const auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	const WorldState worldState({ predicateA, predicateB });
+
+	ASSERT_TRUE(worldState.Has(predicateA->GetAtom()));
+	ASSERT_TRUE(worldState.Has(predicateB->GetAtom()));
+	ASSERT_FALSE(worldState.Has(predicateC->GetAtom()));
+}
+
+TEST(NAI_WorldState, When_SamePredicatesInDifferentOrder_Then_EqualAndSameHash)
+{
+	const auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	const auto predicateB = std::make_shared<BasePredicate>(2, "B");
+
+	const WorldState worldState1({ predicateA, predicateB });
+	const WorldState worldState2({ predicateB, predicateA });
+
+	ASSERT_TRUE(worldState1 == worldState2);
+	ASSERT_EQ(worldState1.GetHash(), worldState2.GetHash());
+}
+
+TEST(NAI_WorldState, When_PredicateIsRemoved_Then_ItIsNotInTheState)
+{
+	const auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	const auto predicateB = std::make_shared<BasePredicate>(2, "B");
+
+	WorldState worldState({ predicateA, predicateB });
+	worldState.Remove(predicateA->GetAtom());
+
+	ASSERT_FALSE(worldState.Has(predicateA->GetAtom()));
+	ASSERT_TRUE(worldState.Has(predicateB->GetAtom()));
+}
+
+TEST(NAI_WorldState, When_PredicateCarriesData_Then_ItIsKeptAsPayload)
+{
+	const auto amountPredicate = std::make_shared<AmountPredicate>(1, "AMOUNT", 5);
+
+	const WorldState worldState({ amountPredicate });
+
+	const auto payloads = worldState.GetPayloads(amountPredicate->GetAtom());
+
+	ASSERT_EQ(payloads.size(), 1);
+	ASSERT_TRUE(payloads[0] == amountPredicate);
+	ASSERT_EQ(std::static_pointer_cast<AmountPredicate>(payloads[0])->GetAmount(), 5);
+}
+
+TEST(NAI_WorldState, When_TwoPredicatesWithSameTextCarryData_Then_BothPayloadsAreKept)
+{
+	const auto amountPredicate1 = std::make_shared<AmountPredicate>(1, "AMOUNT", 5);
+	const auto amountPredicate2 = std::make_shared<AmountPredicate>(2, "AMOUNT", 7);
+
+	WorldState worldState({ amountPredicate1, amountPredicate2 });
+
+	const auto payloads = worldState.GetPayloads(amountPredicate1->GetAtom());
+
+	ASSERT_EQ(payloads.size(), 2);
+	ASSERT_TRUE(payloads[0] == amountPredicate1);
+	ASSERT_TRUE(payloads[1] == amountPredicate2);
+
+	worldState.Remove(amountPredicate1->GetAtom());
+
+	ASSERT_FALSE(worldState.Has(amountPredicate1->GetAtom()));
+	ASSERT_TRUE(worldState.GetPayloads(amountPredicate1->GetAtom()).empty());
+}
+
+TEST(NAI_WorldState, When_AtomIsBeyondTheFixedWidth_Then_StateStillWorks)
+{
+	//the symbol table only grows, so keep interning new texts until one doesn't fit in the fixed width
+	std::shared_ptr<IPredicate> widePredicate;
+	for (unsigned int i = 0; widePredicate == nullptr || widePredicate->GetAtom() < WorldState::GetNumFixedAtoms(); ++i)
+	{
+		widePredicate = std::make_shared<BasePredicate>(2, "WORLD_STATE_WIDE_" + std::to_string(i));
+	}
+	const auto predicateA = std::make_shared<BasePredicate>(1, "A");
+
+	WorldState worldState1({ predicateA, widePredicate });
+	const WorldState worldState2({ widePredicate, predicateA });
+
+	ASSERT_TRUE(worldState1.Has(widePredicate->GetAtom()));
+	ASSERT_TRUE(worldState1 == worldState2);
+	ASSERT_EQ(worldState1.GetHash(), worldState2.GetHash());
+	ASSERT_TRUE(worldState1.Contains(WorldState({ widePredicate })));
+
+	worldState1.Remove(widePredicate->GetAtom());
+
+	ASSERT_FALSE(worldState1.Has(widePredicate->GetAtom()));
+	ASSERT_TRUE(worldState1.Has(predicateA->GetAtom()));
+	ASSERT_TRUE(worldState1 != worldState2);
+}
+
+TEST(NAI_WorldState, When_ActionPreconditionsAreInTheState_Then_IsApplicable)
+{
+	const auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	const auto predicateB = std::make_shared<BasePredicate>(2, "B");
+	const auto predicateC = std::make_shared<BasePredicate>(3, "C");
+
+	std::vector<std::string> preconditions{ predicateA->GetText(), predicateC->GetText() };
+	std::vector<std::shared_ptr<IPredicate>> postconditions{ predicateB };
+	const auto action = std::make_shared<BaseAction>(preconditions, postconditions);
+
+	ASSERT_FALSE(action->IsApplicable(WorldState({ predicateA })));
+	ASSERT_TRUE(action->IsApplicable(WorldState({ predicateC, predicateB, predicateA })));
+}
+
+TEST(NAI_WorldState, When_ApplyingActionPostconditions_Then_StateContainsThem)
+{
+	const auto predicateA = std::make_shared<BasePredicate>(1, "A");
+	const auto predicateB = std::make_shared<BasePredicate>(2, "B");
+
+	std::vector<std::string> preconditions{ predicateA->GetText() };
+	std::vector<std::shared_ptr<IPredicate>> postconditions{ predicateB };
+	const auto action = std::make_shared<BaseAction>(preconditions, postconditions);
+
+	const WorldState worldState({ predicateA });
+	const auto nextWorldState = worldState.Apply(action->GetPostconditionsMask());
+
+	ASSERT_TRUE(nextWorldState.Contains(worldState));
+	ASSERT_TRUE(nextWorldState.Contains(action->GetPostconditionsMask()));
+	ASSERT_TRUE(nextWorldState != worldState);
+}
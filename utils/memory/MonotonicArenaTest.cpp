@@ -0,0 +1,75 @@
+#include "gtest/gtest.h"
+#include "utils/memory/MonotonicArena.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace core::utils::memory;
+
+TEST(CORE_UTILS_MonotonicArena, When_Created_Then_NothingIsUsed)
+{
+	const MonotonicArena arena(1024);
+
+	ASSERT_EQ(arena.GetUsedBytes(), 0);
+	ASSERT_EQ(arena.GetNumAllocations(), 0);
+}
+
+TEST(CORE_UTILS_MonotonicArena, When_Allocating_Then_MemoryIsAligned)
+{
+	MonotonicArena arena(1024);
+
+	arena.Allocate(1, 1);
+	const auto pointer = arena.Allocate(sizeof(double), alignof(double));
+
+	ASSERT_TRUE(pointer != nullptr);
+	ASSERT_EQ(reinterpret_cast<std::uintptr_t>(pointer) % alignof(double), 0);
+	ASSERT_EQ(arena.GetNumAllocations(), 2);
+}
+
+TEST(CORE_UTILS_MonotonicArena, When_Reset_Then_MemoryIsReusedWithoutGrowing)
+{
+	MonotonicArena arena(1024);
+
+	for (auto i = 0; i < 10; ++i)
+	{
+		arena.Allocate(64, 8);
+	}
+	const auto capacity = arena.GetCapacity();
+	ASSERT_GT(arena.GetUsedBytes(), 0);
+
+	arena.Reset();
+
+	ASSERT_EQ(arena.GetUsedBytes(), 0);
+	ASSERT_EQ(arena.GetNumAllocations(), 0);
+
+	for (auto i = 0; i < 10; ++i)
+	{
+		arena.Allocate(64, 8);
+	}
+	ASSERT_EQ(arena.GetCapacity(), capacity);
+}
+
+TEST(CORE_UTILS_MonotonicArena, When_AllocationIsBiggerThanTheBlock_Then_ArenaGrows)
+{
+	MonotonicArena arena(64);
+
+	const auto pointer = arena.Allocate(256, 8);
+
+	ASSERT_TRUE(pointer != nullptr);
+	ASSERT_GE(arena.GetCapacity(), 256);
+}
+
+TEST(CORE_UTILS_MonotonicArena, When_VectorUsesArenaAllocator_Then_ItsElementsComeFromTheArena)
+{
+	MonotonicArena arena(1024);
+	std::vector<int, ArenaAllocator<int>> values{ ArenaAllocator<int>(arena) };
+
+	values.reserve(16);
+	for (auto i = 0; i < 16; ++i)
+	{
+		values.push_back(i);
+	}
+
+	ASSERT_GE(arena.GetUsedBytes(), 16 * sizeof(int));
+	ASSERT_EQ(values[15], 15);
+}
@@ -0,0 +1,142 @@
+#include "gtest/gtest.h"
+#include "utils/timer/TimingWheel.h"
+
+#include <vector>
+
+using namespace core::utils::timer;
+
+TEST(CORE_UTILS_TimingWheel, When_Created_Then_IsEmpty)
+{
+	const TimingWheel<int> wheel(0.1f, 8, 3);
+
+	ASSERT_EQ(wheel.GetSize(), 0);
+}
+
+TEST(CORE_UTILS_TimingWheel, When_DelayIsNotReached_Then_DoesNotExpire)
+{
+	TimingWheel<int> wheel(0.1f, 8, 3);
+	std::vector<int> expired;
+
+	wheel.Schedule(1, 0.5f);
+	wheel.Update(0.3f, [&expired](const int& value) { expired.push_back(value); });
+
+	ASSERT_TRUE(expired.empty());
+	ASSERT_EQ(wheel.GetSize(), 1);
+}
+
+TEST(CORE_UTILS_TimingWheel, When_DelayIsReached_Then_ExpiresOnce)
+{
+	TimingWheel<int> wheel(0.1f, 8, 3);
+	std::vector<int> expired;
+	const auto onExpired = [&expired](const int& value) { expired.push_back(value); };
+
+	wheel.Schedule(1, 0.5f);
+	wheel.Update(0.3f, onExpired);
+	wheel.Update(0.3f, onExpired);
+	wheel.Update(0.3f, onExpired);
+
+	ASSERT_EQ(expired.size(), 1);
+	ASSERT_EQ(expired[0], 1);
+	ASSERT_EQ(wheel.GetSize(), 0);
+}
+
+TEST(CORE_UTILS_TimingWheel, When_SomeValuesWithDifferentDelays_Then_TheyExpireInOrder)
+{
+	TimingWheel<int> wheel(0.1f, 8, 3);
+	std::vector<int> expired;
+	const auto onExpired = [&expired](const int& value) { expired.push_back(value); };
+
+	wheel.Schedule(3, 0.7f);
+	wheel.Schedule(1, 0.1f);
+	wheel.Schedule(2, 0.4f);
+
+	for (auto i = 0; i < 10; ++i)
+	{
+		wheel.Update(0.1f, onExpired);
+	}
+
+	ASSERT_EQ(expired, std::vector<int>({ 1, 2, 3 }));
+}
+
+TEST(CORE_UTILS_TimingWheel, When_DelayIsLongerThanTheFirstLevel_Then_ItCascadesAndExpiresOnTime)
+{
+	//first level covers 0.8 seconds, second one 6.4 seconds
+	TimingWheel<int> wheel(0.1f, 8, 3);
+	std::vector<int> expired;
+	const auto onExpired = [&expired](const int& value) { expired.push_back(value); };
+
+	wheel.Schedule(1, 2.05f);
+
+	auto elapsedTime = 0.0f;
+	while (expired.empty() && elapsedTime < 10.0f)
+	{
+		wheel.Update(0.1f, onExpired);
+		elapsedTime += 0.1f;
+	}
+
+	ASSERT_EQ(expired.size(), 1);
+	ASSERT_GE(elapsedTime, 2.0f);
+	ASSERT_LE(elapsedTime, 2.2f);
+}
+
+TEST(CORE_UTILS_TimingWheel, When_DelayIsLongerThanTheWheel_Then_ExpiresOnTimeAnyway)
+{
+	//both levels cover 8 seconds, ticks are exact in float
+	TimingWheel<int> wheel(0.125f, 8, 2);
+	std::vector<int> expired;
+	const auto onExpired = [&expired](const int& value) { expired.push_back(value); };
+
+	ASSERT_LT(wheel.GetSpan(), 20.0f);
+
+	wheel.Schedule(1, 20.0f);
+
+	for (auto i = 0; i < 159; ++i)
+	{
+		wheel.Update(0.125f, onExpired);
+	}
+
+	ASSERT_TRUE(expired.empty());
+	ASSERT_EQ(wheel.GetSize(), 1);
+
+	wheel.Update(0.125f, onExpired);
+
+	ASSERT_EQ(expired, std::vector<int>({ 1 }));
+	ASSERT_EQ(wheel.GetSize(), 0);
+}
+
+TEST(CORE_UTILS_TimingWheel, When_Cancelled_Then_DoesNotExpire)
+{
+	TimingWheel<int> wheel(0.1f, 8, 3);
+	std::vector<int> expired;
+
+	const auto handle = wheel.Schedule(1, 0.2f);
+	wheel.Schedule(2, 0.2f);
+
+	ASSERT_TRUE(wheel.Cancel(handle));
+	ASSERT_FALSE(wheel.Cancel(handle));
+
+	wheel.Update(0.5f, [&expired](const int& value) { expired.push_back(value); });
+
+	ASSERT_EQ(expired, std::vector<int>({ 2 }));
+}
+
+TEST(CORE_UTILS_TimingWheel, When_ManyValues_Then_AllOfThemExpire)
+{
+	TimingWheel<int> wheel(0.1f, 16, 3);
+	auto numExpired = 0;
+	const auto onExpired = [&numExpired](const int& value) { ++numExpired; };
+
+	const auto numValues = 10000;
+	for (auto i = 0; i < numValues; ++i)
+	{
+		wheel.Schedule(i, 0.1f * (i % 100));
+	}
+
+	for (auto i = 0; i < 110; ++i)
+	{
+		wheel.Update(0.1f, onExpired);
+	}
+
+	ASSERT_EQ(numExpired, numValues);
+	ASSERT_EQ(wheel.GetSize(), 0);
+}